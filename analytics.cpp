@@ -0,0 +1,118 @@
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include "analytics.h"
+
+namespace {
+
+constexpr int TILE_SIDE {4};                    // tiles are 4x4, one nibble of four rows
+constexpr int TILE_CODES {1 << (TILE_SIDE * TILE_SIDE)};
+
+// partial sums of one band of rows
+struct BandCounts {
+    std::vector<uint32_t> tiles = std::vector<uint32_t>(TILE_CODES, 0);  // histogram of tile codes
+    std::vector<uint64_t> pairs;                // live pairs at each distance, both directions
+};
+
+// the 64 cells of a row starting at column start, wrapping around the torus
+uint64_t shiftedWord(const uint64_t* row, const int cols, const int start) {
+    if (start + 63 < cols) {
+        const int word  = start / 64;
+        const int shift = start % 64;
+        return shift == 0 ? row[word] : (row[word] >> shift) | (row[word + 1] << (64 - shift));
+    }
+
+    // the window crosses the right edge
+    uint64_t bits = 0;
+    for (int b = 0; b < 64; b++) {
+        const int col = (start + b) % cols;
+        bits |= ((row[col / 64] >> (col % 64)) & 1) << b;
+    }
+    return bits;
+}
+
+void countBand(const Snapshot& snapshot, const int firstRow, const int lastRow, BandCounts& counts) {
+    const int wordsPerRow = snapshot.wordsPerRow;
+    const int distances = static_cast<int>(counts.pairs.size());
+    const auto row = [&](const int r) { return &snapshot.words[static_cast<size_t>(r) * wordsPerRow]; };
+
+    for (int r = firstRow; r < lastRow; r++) {
+        const uint64_t* cells = row(r);
+        for (int d = 1; d <= distances; d++) {
+            const uint64_t* below = row((r + d) % snapshot.rows);
+            for (int w = 0; w < wordsPerRow; w++) {
+                // bits past the last column are zero in cells, so they never pair up
+                counts.pairs[d - 1] += std::popcount(cells[w] & below[w]);
+                counts.pairs[d - 1] += std::popcount(cells[w] & shiftedWord(cells, snapshot.cols, w * 64 + d));
+            }
+        }
+
+        // tiles start on rows that are multiples of the tile side, partial tiles are skipped
+        if (r % TILE_SIDE != 0 || r + TILE_SIDE > snapshot.rows) continue;
+        for (int w = 0; w < wordsPerRow; w++) {
+            const int nibbles = std::min(64, snapshot.cols - w * 64) / TILE_SIDE;
+            for (int n = 0; n < nibbles; n++) {
+                uint32_t code = 0;
+                for (int k = 0; k < TILE_SIDE; k++) {
+                    code |= static_cast<uint32_t>((row(r + k)[w] >> (n * TILE_SIDE)) & 0xf) << (k * TILE_SIDE);
+                }
+                counts.tiles[code]++;
+            }
+        }
+    }
+}
+
+} // namespace
+
+Analytics analyzeSnapshot(const Snapshot& snapshot, const int maxDistance, ThreadPool& pool) {
+    Analytics result;
+    result.generation = snapshot.generation;
+    result.aliveCells = snapshot.aliveCells;
+    const double cells = static_cast<double>(snapshot.rows) * snapshot.cols;
+    if (cells == 0) {
+        return result;
+    }
+
+    // bands start on tile boundaries so each tile is counted by exactly one band
+    const int bandCount = std::max(1, std::min(pool.size(), snapshot.rows / TILE_SIDE));
+    const int bandRows  = (snapshot.rows / bandCount + TILE_SIDE - 1) / TILE_SIDE * TILE_SIDE;
+    std::vector<BandCounts> bands(bandCount);
+    pool.parallelFor(bandCount, 1, [&](const size_t begin, const size_t end) {
+        for (size_t band = begin; band < end; band++) {
+            bands[band].pairs.assign(maxDistance, 0);
+            const int first = static_cast<int>(band) * bandRows;
+            const int last  = band + 1 == static_cast<size_t>(bandCount) ? snapshot.rows
+                                                                          : std::min(snapshot.rows, first + bandRows);
+            countBand(snapshot, first, last, bands[band]);
+        }
+    });
+
+    std::vector<uint64_t> tiles(TILE_CODES, 0);
+    std::vector<uint64_t> pairs(maxDistance, 0);
+    for (const auto& band : bands) {
+        for (int code = 0; code < TILE_CODES; code++) {
+            tiles[code] += band.tiles[code];
+        }
+        for (int d = 0; d < maxDistance; d++) {
+            pairs[d] += band.pairs[d];
+        }
+    }
+
+    uint64_t tileCount = 0;
+    for (const uint64_t count : tiles) {
+        tileCount += count;
+    }
+    for (const uint64_t count : tiles) {
+        if (count == 0) continue;
+        const double p = static_cast<double>(count) / static_cast<double>(tileCount);
+        result.entropy -= p * std::log2(p);
+    }
+
+    // covariance of two cells d apart, averaged over the horizontal and vertical pairs
+    result.density = snapshot.aliveCells / cells;
+    for (int d = 0; d < maxDistance; d++) {
+        result.correlation.push_back(static_cast<double>(pairs[d]) / (2 * cells) - result.density * result.density);
+    }
+    return result;
+}
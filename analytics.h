@@ -0,0 +1,23 @@
+#ifndef ANALYTICS_H
+#define ANALYTICS_H
+
+#include <vector>
+#include "snapshot.h"
+#include "threadpool.h"
+
+// spatial statistics of one generation
+struct Analytics {
+    int generation {};
+    int aliveCells {};
+    double density {};                          // fraction of live cells
+    double entropy {};                          // Shannon entropy of 4x4 tiles in bits (0-16)
+    std::vector<double> correlation;            // two-point correlation at distances 1, 2, ...
+};
+
+// computes the statistics of a packed snapshot on the torus: tiles are read as 4-bit
+// nibbles of four rows into a histogram, and correlation counts come from popcounts of
+// a row ANDed with a row below it and with itself shifted right. Row bands are reduced
+// separately on the pool and summed afterwards
+Analytics analyzeSnapshot(const Snapshot& snapshot, int maxDistance, ThreadPool& pool);
+
+#endif
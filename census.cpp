@@ -0,0 +1,341 @@
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <queue>
+#include <set>
+#include <string_view>
+#include "census.h"
+#include "textio.h"
+
+namespace {
+
+constexpr int    MAX_PHASES      {64};      // phases examined when looking for the period of an object
+constexpr size_t MAX_OPEN_FILES {256};      // inputs merged in a single pass
+constexpr size_t MAX_LINE_LENGTH {1 << 20}; // bytes per census line, far more than any object code needs
+constexpr char   HEX_DIGITS[] {"0123456789abcdef"};
+constexpr std::string_view CENSUS_VERSION {"# census v1"};   // first line of every census
+constexpr std::string_view CENSUS_COLUMNS {"hash,count,code"};   // last line of the header
+
+using Cells = std::vector<std::pair<int, int>>;
+
+// moves the cells so that their bounding box starts at (0, 0) and sorts them
+Cells normalize(Cells cells) {
+    int minRow = INT_MAX;
+    int minCol = INT_MAX;
+    for (const auto& [row, col] : cells) {
+        minRow = std::min(minRow, row);
+        minCol = std::min(minCol, col);
+    }
+    for (auto& [row, col] : cells) {
+        row -= minRow;
+        col -= minCol;
+    }
+    std::sort(cells.begin(), cells.end());
+    return cells;
+}
+
+// applies one of the 8 symmetries of the square to the cells
+Cells orient(Cells cells, const int orientation) {
+    for (auto& [row, col] : cells) {
+        if (orientation & 1) std::swap(row, col);
+        if (orientation & 2) row = -row;
+        if (orientation & 4) col = -col;
+    }
+    return cells;
+}
+
+// computes the next generation of the cells on an unbounded plane
+Cells step(const Cells& cells) {
+    const std::set<std::pair<int, int>> alive(cells.begin(), cells.end());
+    std::map<std::pair<int, int>, int> neighbors;
+
+    for (const auto& [row, col] : cells) {
+        for (int dRow = -1; dRow <= 1; dRow++) {
+            for (int dCol = -1; dCol <= 1; dCol++) {
+                if (dRow == 0 && dCol == 0) continue;
+                neighbors[{row + dRow, col + dCol}]++;
+            }
+        }
+    }
+
+    Cells next;
+    for (const auto& [cell, count] : neighbors) {
+        if (count == 3 || (count == 2 && alive.contains(cell))) {
+            next.push_back(cell);
+        }
+    }
+    return next;
+}
+
+// encodes normalized cells as "WxH:" followed by hex digits per row (4 columns each)
+std::string encode(const Cells& cells) {
+    int height = 0;
+    int width  = 0;
+    for (const auto& [row, col] : cells) {
+        height = std::max(height, row + 1);
+        width  = std::max(width, col + 1);
+    }
+
+    const int digits = (width + 3) / 4;
+    std::vector<int> nibbles(static_cast<size_t>(height) * digits, 0);
+    for (const auto& [row, col] : cells) {
+        nibbles[row * digits + col / 4] |= 1 << (col % 4);
+    }
+
+    std::string code = std::to_string(width) + "x" + std::to_string(height) + ":";
+    for (int row = 0; row < height; row++) {
+        if (row > 0) code.push_back('.');
+        for (int digit = 0; digit < digits; digit++) {
+            code.push_back(HEX_DIGITS[nibbles[row * digits + digit]]);
+        }
+    }
+    return code;
+}
+
+// orders codes by length first, so smaller bounding boxes win
+bool codeLess(const std::string& a, const std::string& b) {
+    return a.size() != b.size() ? a.size() < b.size() : a < b;
+}
+
+void writeHeader(std::ostream& out, const std::vector<std::string>& notes = {}) {
+    out << CENSUS_VERSION << '\n';
+    for (const auto& note : notes) {
+        out << "# " << note << '\n';
+    }
+    out << CENSUS_COLUMNS << '\n';
+}
+
+void writeEntry(std::ostream& out, const CensusEntry& entry) {
+    out << formatHash(entry.hash) << ',' << entry.count << ',' << entry.code << '\n';
+}
+
+// parses a "hash,count,code" line, returns false if it is malformed
+bool parseEntry(const std::string& line, CensusEntry& entry) {
+    const auto first  = line.find(',');
+    const auto second = line.find(',', first + 1);
+    if (first != 16 || second == std::string::npos) {
+        return false;
+    }
+    try {
+        entry.hash  = std::stoull(line.substr(0, first), nullptr, 16);
+        entry.count = std::stoull(line.substr(first + 1, second - first - 1));
+    } catch (const std::exception&) {
+        return false;
+    }
+    entry.code = line.substr(second + 1);
+    return true;
+}
+
+// one input of a merge pass
+struct CensusInput {
+    std::ifstream file;
+    CensusReader reader {file};
+
+    explicit CensusInput(const std::string& path) : file(path) {}
+};
+
+// merges up to MAX_OPEN_FILES sorted inputs into one sorted output
+bool mergePass(const std::vector<std::string>& inputs, const std::string& output) {
+    using HeapItem = std::pair<uint64_t, size_t>;   // hash of the current entry, reader index
+    std::priority_queue<HeapItem, std::vector<HeapItem>, std::greater<>> heap;
+    std::vector<std::unique_ptr<CensusInput>> readers;
+
+    for (const auto& path : inputs) {
+        readers.push_back(std::make_unique<CensusInput>(path));
+        CensusReader& reader = readers.back()->reader;
+        if (!readers.back()->file) {
+            return false;
+        }
+        if (reader.next()) {
+            heap.emplace(reader.entry().hash, readers.size() - 1);
+        }
+    }
+
+    // the notes of every input are kept, e.g. the state digests of the runs merged
+    std::vector<std::string> notes;
+    for (const auto& input : readers) {
+        for (const auto& note : input->reader.notes()) {
+            if (std::ranges::find(notes, note) == notes.end()) {
+                notes.push_back(note);
+            }
+        }
+    }
+
+    std::ofstream out(output);
+    writeHeader(out, notes);
+
+    CensusEntry pending;
+    bool hasPending = false;
+    while (!heap.empty()) {
+        const auto [hash, index] = heap.top();
+        heap.pop();
+
+        CensusReader& reader = readers[index]->reader;
+        if (hasPending && pending.hash == hash) {
+            pending.count += reader.entry().count;
+        } else {
+            if (hasPending) writeEntry(out, pending);
+            pending = reader.entry();
+            hasPending = true;
+        }
+
+        if (reader.next()) {
+            heap.emplace(reader.entry().hash, index);
+        }
+    }
+    if (hasPending) writeEntry(out, pending);
+
+    for (const auto& input : readers) {
+        if (input->reader.failed()) {
+            return false;
+        }
+    }
+    out.flush();
+    return out.good();
+}
+
+} // namespace
+
+bool CensusReader::next() {
+    const uint64_t previous = current.hash;
+    std::string line;
+    while (!malformed && readLine(in, line, MAX_LINE_LENGTH)) {
+        if (line.starts_with("# ") && line != CENSUS_VERSION) {
+            headerNotes.push_back(line.substr(2));
+        } else if (line.starts_with('#') || line == CENSUS_COLUMNS) {
+            continue;
+        } else if (parseEntry(line, current)) {
+            sorted = sorted && previous <= current.hash;
+            return true;
+        } else {
+            malformed = true;
+        }
+    }
+    return false;
+}
+
+std::string canonicalCode(const std::vector<std::pair<int, int>>& cells) {
+    Cells phase = normalize(cells);
+    const Cells first = phase;
+    std::string best = encode(phase);
+
+    // the smallest code over all phases and orientations
+    for (int i = 0; i < MAX_PHASES && !phase.empty(); i++) {
+        for (int orientation = 0; orientation < 8; orientation++) {
+            std::string code = encode(normalize(orient(phase, orientation)));
+            if (codeLess(code, best)) {
+                best = std::move(code);
+            }
+        }
+        phase = normalize(step(phase));
+        if (phase == first) {
+            break;  // full period examined
+        }
+    }
+    return best;
+}
+
+Motion objectMotion(const std::vector<std::pair<int, int>>& cells) {
+    const auto corner = [](const Cells& phase) {
+        std::pair<int, int> result {INT_MAX, INT_MAX};
+        for (const auto& [row, col] : phase) {
+            result.first  = std::min(result.first, row);
+            result.second = std::min(result.second, col);
+        }
+        return result;
+    };
+
+    const Cells first = normalize(cells);
+    const auto start = corner(cells);
+    Cells phase = cells;
+
+    for (int period = 1; period <= MAX_PHASES && !phase.empty(); period++) {
+        phase = step(phase);
+        if (phase.size() > 2 * first.size()) {
+            break;  // still evolving, not a periodic object
+        }
+        if (normalize(phase) == first) {
+            const auto end = corner(phase);
+            return {period, end.first - start.first, end.second - start.second};
+        }
+    }
+    return {};
+}
+
+uint64_t hashCode(const std::string& code) {
+    uint64_t hash = 14695981039346656037ull;
+    for (const unsigned char c : code) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+std::string formatHash(const uint64_t hash) {
+    std::string result(16, '0');
+    for (int i = 15; i >= 0; i--) {
+        result[i] = HEX_DIGITS[(hash >> (4 * (15 - i))) & 0xf];
+    }
+    return result;
+}
+
+void Census::add(const std::vector<std::pair<int, int>>& cells) {
+    const std::string code = canonicalCode(cells);
+    add(hashCode(code), 1, code);
+}
+
+void Census::add(const uint64_t hash, const uint64_t count, const std::string& code) {
+    CensusEntry& entry = entries[hash];
+    entry.hash = hash;
+    entry.count += count;
+    if (entry.code.empty()) {
+        entry.code = code;
+    }
+}
+
+bool Census::write(const std::string& path) const {
+    std::vector<const CensusEntry*> sorted;
+    sorted.reserve(entries.size());
+    for (const auto& [hash, entry] : entries) {
+        sorted.push_back(&entry);
+    }
+    std::sort(sorted.begin(), sorted.end(),
+              [](const CensusEntry* a, const CensusEntry* b) { return a->hash < b->hash; });
+
+    std::ofstream out(path);
+    writeHeader(out, notes);
+    for (const CensusEntry* entry : sorted) {
+        writeEntry(out, *entry);
+    }
+    out.flush();
+    return out.good();
+}
+
+bool mergeCensusFiles(const std::vector<std::string>& inputs, const std::string& output) {
+    std::vector<std::string> level = inputs;
+    std::vector<std::string> temporary;
+    bool ok = true;
+
+    // merge groups of files into temporary files until one pass can open all of them
+    for (int pass = 0; ok && level.size() > MAX_OPEN_FILES; pass++) {
+        std::vector<std::string> next;
+        for (size_t i = 0; ok && i < level.size(); i += MAX_OPEN_FILES) {
+            const auto end = std::min(level.size(), i + MAX_OPEN_FILES);
+            const std::vector<std::string> group(level.begin() + i, level.begin() + end);
+            const std::string part = output + ".part" + std::to_string(pass) + "_" + std::to_string(next.size());
+            temporary.push_back(part);
+            next.push_back(part);
+            ok = mergePass(group, part);
+        }
+        level = std::move(next);
+    }
+
+    ok = ok && mergePass(level, output);
+    for (const auto& path : temporary) {
+        std::remove(path.c_str());
+    }
+    return ok;
+}
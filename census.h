@@ -0,0 +1,92 @@
+#ifndef CENSUS_H
+#define CENSUS_H
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+/*
+ * Census - counts of objects left over by stabilized soups.
+ *
+ * Objects are keyed by the hash of their canonical code, which is the same
+ * for every phase, orientation and position of the object. Census files are
+ * CSV lines "hash,count,code" sorted by hash, so any number of partial files
+ * can be combined with a streaming k-way merge (see census_merge.cpp).
+ */
+struct CensusEntry {
+    uint64_t hash  {};                          // hash of the canonical code
+    uint64_t count {};                          // number of occurrences
+    std::string code;                           // canonical code of the object
+};
+
+class Census {
+    std::unordered_map<uint64_t, CensusEntry> entries;
+    std::vector<std::string> notes;             // comment lines written to the header
+
+public:
+    // adds an object given by its cell coordinates
+    void add(const std::vector<std::pair<int, int>>& cells);
+
+    // adds an already canonicalized object
+    void add(uint64_t hash, uint64_t count, const std::string& code);
+
+    // adds a comment line to the file header, e.g. run parameters
+    void addNote(const std::string& note) { notes.push_back(note); }
+
+    size_t size() const { return entries.size(); }
+
+    // writes the census sorted by hash, returns false on I/O error
+    bool write(const std::string& path) const;
+};
+
+// reads a census file entry by entry; comment lines before the entries are kept as notes
+class CensusReader {
+    std::istream& in;
+    CensusEntry current;
+    std::vector<std::string> headerNotes;
+    bool sorted    {true};                      // false once an out-of-order entry was seen
+    bool malformed {};                          // true once a line was neither comment, header nor entry
+
+public:
+    explicit CensusReader(std::istream& in) : in(in) {}
+
+    // reads the next entry, returns false at the end of the input, on a read error or
+    // on a malformed line
+    bool next();
+
+    // the entry read by the last successful next()
+    const CensusEntry& entry() const { return current; }
+
+    // notes of the header read so far, without their "# "
+    const std::vector<std::string>& notes() const { return headerNotes; }
+
+    // whether the input could not be read, had a malformed line or was not sorted by hash
+    bool failed() const { return in.bad() || malformed || !sorted; }
+};
+
+// returns the code shared by all phases and orientations of the object
+std::string canonicalCode(const std::vector<std::pair<int, int>>& cells);
+
+// movement of an object over one period
+struct Motion {
+    int period {};                              // 0 if the object does not repeat within the examined phases
+    int dRow   {};                              // displacement per period, non-zero for spaceships
+    int dCol   {};
+};
+
+// evolves the object in isolation to find its period and displacement
+Motion objectMotion(const std::vector<std::pair<int, int>>& cells);
+
+// 64-bit FNV-1a hash of a canonical code
+uint64_t hashCode(const std::string& code);
+
+// formats a hash as 16 hex digits
+std::string formatHash(uint64_t hash);
+
+// merges sorted census files into one with the notes of all of them, keeping at most a
+// line per open file in memory; fails on a malformed or unsorted input
+bool mergeCensusFiles(const std::vector<std::string>& inputs, const std::string& output);
+
+#endif
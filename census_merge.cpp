@@ -0,0 +1,37 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include "census.h"
+
+/*
+ * census_merge - combines partial census files written by soup search runs.
+ *
+ * Usage: census_merge <output.csv> <input.csv>...
+ * An input of "-" reads further input paths from stdin, one per line, which
+ * avoids command line length limits when merging thousands of files.
+ */
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <output.csv> <input.csv>... (- reads paths from stdin)\n";
+        return 1;
+    }
+
+    std::vector<std::string> inputs;
+    for (int i = 2; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (arg == "-") {
+            std::string path;
+            while (std::getline(std::cin, path)) {
+                if (!path.empty()) inputs.push_back(path);
+            }
+        } else {
+            inputs.push_back(arg);
+        }
+    }
+
+    if (!mergeCensusFiles(inputs, argv[1])) {
+        std::cerr << "Failed to merge census files (missing, unreadable, malformed or unsorted input)\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,123 @@
+#include <algorithm>
+#include <cstdio>
+#include "checkpoint.h"
+#include "textio.h"
+
+namespace {
+
+constexpr size_t MAX_HEADER_LINE {64};          // size, generation and stats lines
+constexpr char HEADER_V1[] {"# GameOfLife checkpoint v1"};     // one character per cell
+constexpr char HEADER_V2[] {"# GameOfLife checkpoint v2"};     // runs of cells
+
+// reads a "key values" line and returns the values
+bool readField(std::istream& in, const std::string& key, std::string& values, const size_t maxLength) {
+    std::string line;
+    if (!readLine(in, line, key.size() + 1 + maxLength) || line.compare(0, key.size() + 1, key + " ") != 0) {
+        return false;
+    }
+    values = line.substr(key.size() + 1);
+    return true;
+}
+
+// fills a row from '.' and 'o' characters, returns the number of alive cells or -1
+long long parseCells(const std::string& line, std::vector<bool>& row) {
+    if (line.size() != row.size()) return -1;
+    long long alive = 0;
+    for (size_t j = 0; j < line.size(); j++) {
+        if (line[j] != '.' && line[j] != 'o') return -1;
+        row[j] = line[j] == 'o';
+        alive += row[j];
+    }
+    return alive;
+}
+
+// fills a row from runs like "3b2o", returns the number of alive cells or -1
+long long parseRuns(const std::string& line, std::vector<bool>& row) {
+    const long long cols = static_cast<long long>(row.size());
+    long long col = 0;
+    long long alive = 0;
+    long long count = 0;
+    bool counted = false;
+
+    for (const char c : line) {
+        if (c >= '0' && c <= '9') {
+            count = count * 10 + (c - '0');
+            counted = true;
+            if (count > cols) return -1;     // also keeps the count from overflowing
+            continue;
+        }
+        if (c != 'b' && c != 'o') return -1;
+
+        const long long run = counted ? count : 1;
+        if (run == 0 || col + run > cols) return -1;
+        if (c == 'o') {
+            std::fill(row.begin() + col, row.begin() + col + run, true);
+            alive += run;
+        }
+        col += run;
+        count = 0;
+        counted = false;
+    }
+    return counted ? -1 : alive;
+}
+
+} // namespace
+
+void writeCheckpoint(std::ostream& out, const CheckpointInfo& info, const std::vector<std::vector<bool>>& grid) {
+    out << HEADER_V2 << "\n";
+    out << "pattern "    << info.pattern << "\n";
+    out << "size "       << info.rows << " " << info.cols << "\n";
+    out << "generation " << info.generation << "\n";
+    out << "stats "      << info.aliveCells << " " << info.totalBirths << " " << info.totalDeaths << "\n";
+
+    std::string line;
+    for (const auto& row : grid) {
+        line.clear();
+        auto cell = row.begin();
+        while (cell != row.end()) {
+            const bool alive = *cell;
+            const auto end = std::find(cell, row.end(), !alive);
+            if (!alive && end == row.end()) break;  // trailing dead cells
+
+            const auto run = end - cell;
+            if (run > 1) line += std::to_string(run);
+            line.push_back(alive ? 'o' : 'b');
+            cell = end;
+        }
+        out << line << '\n';
+    }
+}
+
+bool readCheckpoint(std::istream& in, Checkpoint& checkpoint, const CheckpointLimits& limits) {
+    CheckpointInfo& info = checkpoint.info;
+    std::string line, values;
+    char rest = 0;
+
+    if (!readLine(in, line, MAX_HEADER_LINE) || (line != HEADER_V1 && line != HEADER_V2)) return false;
+    const bool runs = line == HEADER_V2;
+    if (!readField(in, "pattern", info.pattern, limits.maxNameLength)) return false;
+
+    if (!readField(in, "size", values, MAX_HEADER_LINE) ||
+        std::sscanf(values.c_str(), "%d %d %c", &info.rows, &info.cols, &rest) != 2) return false;
+    if (info.rows <= 0 || info.cols <= 0 || info.rows > limits.maxSide || info.cols > limits.maxSide ||
+        static_cast<long long>(info.rows) * info.cols > limits.maxCells) return false;
+
+    if (!readField(in, "generation", values, MAX_HEADER_LINE) ||
+        std::sscanf(values.c_str(), "%d %c", &info.generation, &rest) != 1 || info.generation < 0) return false;
+    if (!readField(in, "stats", values, MAX_HEADER_LINE) ||
+        std::sscanf(values.c_str(), "%d %d %d %c", &info.aliveCells, &info.totalBirths,
+                    &info.totalDeaths, &rest) != 3) return false;
+
+    // the grid grows row by row, so memory follows the input actually read rather than
+    // the size it claims; a row of runs is never longer than a row of cells
+    checkpoint.grid.clear();
+    long long alive = 0;
+    for (int i = 0; i < info.rows; i++) {
+        if (!readLine(in, line, info.cols)) return false;
+        std::vector<bool>& row = checkpoint.grid.emplace_back(info.cols, false);
+        const long long rowAlive = runs ? parseRuns(line, row) : parseCells(line, row);
+        if (rowAlive < 0) return false;
+        alive += rowAlive;
+    }
+    return alive == info.aliveCells;
+}
@@ -0,0 +1,42 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// bounds on checkpoints read from untrusted files, checked before anything is allocated
+struct CheckpointLimits {
+    int maxSide          {1 << 16};             // rows or columns
+    long long maxCells   {1ll << 28};           // rows * columns
+    size_t maxNameLength {256};                 // pattern name
+};
+
+// everything a checkpoint stores besides the cells
+struct CheckpointInfo {
+    std::string pattern;
+    int rows        {};
+    int cols        {};
+    int generation  {};
+    int aliveCells  {};
+    int totalBirths {};
+    int totalDeaths {};
+};
+
+struct Checkpoint {
+    CheckpointInfo info;
+    std::vector<std::vector<bool>> grid;
+};
+
+// writes a checkpoint, each row as runs of dead (b) and alive (o) cells like RLE rows
+// ("3b2o" is three dead then two alive cells, trailing dead cells are left out)
+void writeCheckpoint(std::ostream& out, const CheckpointInfo& info, const std::vector<std::vector<bool>>& grid);
+
+// parses a checkpoint, returns false if it is malformed or exceeds the limits; reads
+// at most one line past the point where the input stops making sense. Runs are filled
+// into the grid a range at a time, never cell by cell. Version 1 files with one
+// character per cell are still read
+bool readCheckpoint(std::istream& in, Checkpoint& checkpoint, const CheckpointLimits& limits = {});
+
+#endif
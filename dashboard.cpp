@@ -0,0 +1,113 @@
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <string_view>
+#include "dashboard.h"
+#include "density.h"
+
+namespace {
+
+constexpr int MIN_PANEL_COLS {8};               // narrower panels are not worth showing
+constexpr int MIN_PANEL_ROWS {2};               // lower ones neither
+
+// appends one character row of a panel, padded to its width
+void appendPanelRow(FrameBuffer& frame, const Snapshot& snapshot, const DashboardLayout& layout, const int y) {
+    const int scale = layout.scale;
+    const uint32_t area = static_cast<uint32_t>(2 * scale * scale);
+    const int top   = y * 2 * scale;
+    for (int x = 0; x < layout.panelCols; x++) {
+        const int left = x * scale;
+        uint32_t count = 0;
+        if (top < snapshot.rows && left < snapshot.cols) {
+            for (int row = top; row < std::min(snapshot.rows, top + 2 * scale); row++) {
+                count += countCells(snapshot, row, left, std::min(snapshot.cols, left + scale));
+            }
+        }
+        frame << densityShade(count, area);
+    }
+}
+
+// appends the title of a panel cut or padded to its width
+void appendTitle(FrameBuffer& frame, const Snapshot& snapshot, const int index, const int width) {
+    char title[64];
+    const int length = snapshot.rows > 0
+        ? std::snprintf(title, sizeof(title), "#%d g%d a%d", index + 1, snapshot.generation, snapshot.aliveCells)
+        : std::snprintf(title, sizeof(title), "#%d", index + 1);
+    const int shown = std::min(length, width);
+    frame << "\033[7m" << std::string_view(title, shown);
+    for (int k = shown; k < width; k++) {
+        frame << ' ';
+    }
+    frame << "\033[0m";
+}
+
+} // namespace
+
+DashboardLayout layoutDashboard(const int universes, const int rows, const int cols,
+                                const int terminalRows, const int terminalCols) {
+    const int height = std::max(1, terminalRows - 1);   // the last line holds the totals
+    DashboardLayout best {};
+    int bestScale = INT_MAX;
+
+    for (int columns = 1; columns <= universes; columns++) {
+        const int panelRowsAcross = (universes + columns - 1) / columns;
+        const int width     = (terminalCols - (columns - 1)) / columns;
+        const int panelRows = height / panelRowsAcross - 1;
+        if (width < MIN_PANEL_COLS || panelRows < MIN_PANEL_ROWS) continue;
+
+        const int scale = std::max({1, (cols + width - 1) / width, (rows + 2 * panelRows - 1) / (2 * panelRows)});
+        if (scale < bestScale) {
+            bestScale = scale;
+            best = {columns, universes, scale, 0, 0};
+        }
+    }
+
+    // too many universes for the terminal, show as many of the smallest panels as fit
+    if (bestScale == INT_MAX) {
+        const int columns = std::max(1, (terminalCols + 1) / (MIN_PANEL_COLS + 1));
+        const int panelRowsAcross = std::max(1, height / (MIN_PANEL_ROWS + 1));
+        const int scale = std::max({1, (cols + MIN_PANEL_COLS - 1) / MIN_PANEL_COLS,
+                                    (rows + 2 * MIN_PANEL_ROWS - 1) / (2 * MIN_PANEL_ROWS)});
+        best = {columns, std::min(universes, columns * panelRowsAcross), scale, 0, 0};
+    }
+
+    best.panelCols = (cols + best.scale - 1) / best.scale;
+    best.panelRows = (rows + 2 * best.scale - 1) / (2 * best.scale);
+    return best;
+}
+
+void renderDashboard(FrameBuffer& frame, const std::vector<Snapshot>& snapshots, const DashboardLayout& layout,
+                     const int universes) {
+    const int shown = std::min(layout.shown, static_cast<int>(snapshots.size()));
+    for (int first = 0; first < shown; first += layout.columns) {
+        const int last = std::min(shown, first + layout.columns);
+        for (int y = -1; y < layout.panelRows; y++) {
+            for (int k = first; k < last; k++) {
+                if (k > first) {
+                    frame << ' ';
+                }
+                if (y < 0) {
+                    appendTitle(frame, snapshots[k], k, layout.panelCols);
+                } else {
+                    appendPanelRow(frame, snapshots[k], layout, y);
+                }
+            }
+            frame << "\033[K\n";    // clears what a wider earlier frame left
+        }
+    }
+
+    // only the shown universes are read, reading all of them every frame would not scale
+    int minGeneration = INT_MAX, maxGeneration = 0;
+    long long alive = 0;
+    for (int k = 0; k < shown; k++) {
+        minGeneration = std::min(minGeneration, snapshots[k].generation);
+        maxGeneration = std::max(maxGeneration, snapshots[k].generation);
+        alive += snapshots[k].aliveCells;
+    }
+    frame << "Universes: "              << universes
+          << " | Shown: "               << shown
+          << " | Generations shown: "   << (shown == 0 ? 0 : minGeneration) << "-" << maxGeneration
+          << " | Alive cells shown: "   << alive
+          << " | Scale: 1:"             << layout.scale
+          << " | Frame: "               << frame.getBuildTime().count() / 1000 << " us\033[K\033[J";
+}
@@ -0,0 +1,36 @@
+#ifndef DASHBOARD_H
+#define DASHBOARD_H
+
+#include <vector>
+#include "framebuffer.h"
+#include "snapshot.h"
+
+constexpr int DASHBOARD_LINE_ESCAPES {64};      // bytes of escape sequences a dashboard line may add
+
+/*
+ * DashboardLayout - how universes are tiled on the terminal.
+ *
+ * Every universe gets a panel of the same size: a title line above its cells
+ * downsampled so that each character covers a block of scale columns and
+ * 2 * scale rows, characters being about twice as tall as wide.
+ */
+struct DashboardLayout {
+    int columns    {};                          // panels across
+    int shown      {};                          // panels that fit, the first universes are shown
+    int scale      {};                          // cell columns per character
+    int panelRows  {};                          // character rows of a panel without its title
+    int panelCols  {};                          // character columns of a panel
+};
+
+// picks the number of panels across that shows the universes at the finest scale,
+// every universe being rows x cols cells
+DashboardLayout layoutDashboard(int universes, int rows, int cols, int terminalRows, int terminalCols);
+
+// appends the panels and totals of one dashboard frame after frame.begin(), universes
+// being the number of them including those not shown; the generation range and alive
+// cells cover the shown snapshots only. Snapshots never published yet (rows == 0) show
+// as empty panels
+void renderDashboard(FrameBuffer& frame, const std::vector<Snapshot>& snapshots, const DashboardLayout& layout,
+                     int universes);
+
+#endif
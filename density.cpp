@@ -0,0 +1,95 @@
+#include <algorithm>
+#include <bit>
+#include <string_view>
+#include "density.h"
+
+namespace {
+
+constexpr uint64_t EVERY_SECOND_BIT {0x5555555555555555ull};
+constexpr uint64_t EVERY_SECOND_PAIR {0x3333333333333333ull};
+constexpr uint64_t LOW_NIBBLES {0x0f0f0f0f0f0f0f0full};
+constexpr std::string_view SHADES {" .:-=+*#%@"};   // empty to full block
+
+// live cells of each byte of a word, kept in that byte (0-8)
+uint64_t bytePopcounts(uint64_t word) {
+    word -= (word >> 1) & EVERY_SECOND_BIT;
+    word = (word & EVERY_SECOND_PAIR) + ((word >> 2) & EVERY_SECOND_PAIR);
+    return (word + (word >> 4)) & LOW_NIBBLES;
+}
+
+// 8x8 blocks: each byte of a word is one block column, so the byte counts of up to
+// eight rows are summed in place (at most 64 per byte) and split once per word
+void countBlocks8(const Snapshot& snapshot, DensityMap& map, const int blockRow) {
+    const int first = blockRow * 8;
+    const int last  = std::min(snapshot.rows, first + 8);
+    uint32_t* counts = &map.counts[static_cast<size_t>(blockRow) * map.cols];
+
+    for (int word = 0; word < snapshot.wordsPerRow; word++) {
+        uint64_t sums = 0;
+        for (int row = first; row < last; row++) {
+            sums += bytePopcounts(snapshot.words[static_cast<size_t>(row) * snapshot.wordsPerRow + word]);
+        }
+        const int blocks = std::min(8, map.cols - word * 8);
+        for (int b = 0; b < blocks; b++) {
+            counts[word * 8 + b] = static_cast<uint32_t>((sums >> (b * 8)) & 0xff);
+        }
+    }
+}
+
+// any other size: popcount of the bits of each row inside each block
+void countBlocks(const Snapshot& snapshot, DensityMap& map, const int blockRow) {
+    const int size  = map.blockSize;
+    const int first = blockRow * size;
+    const int last  = std::min(snapshot.rows, first + size);
+    uint32_t* counts = &map.counts[static_cast<size_t>(blockRow) * map.cols];
+
+    for (int row = first; row < last; row++) {
+        for (int block = 0; block < map.cols; block++) {
+            const int begin = block * size;
+            counts[block] += countCells(snapshot, row, begin, std::min(snapshot.cols, begin + size));
+        }
+    }
+}
+
+} // namespace
+
+// the columns may span two or more words, each masked to the bits inside them
+uint32_t countCells(const Snapshot& snapshot, const int row, const int begin, const int end) {
+    const uint64_t* words = &snapshot.words[static_cast<size_t>(row) * snapshot.wordsPerRow];
+    uint32_t count = 0;
+    for (int col = begin; col < end; ) {
+        const int bit   = col % 64;
+        const int taken = std::min(64 - bit, end - col);
+        const uint64_t mask = taken == 64 ? ~0ull : ((1ull << taken) - 1) << bit;
+        count += std::popcount(words[col / 64] & mask);
+        col += taken;
+    }
+    return count;
+}
+
+char densityShade(const uint32_t count, const uint32_t area) {
+    if (count == 0) {
+        return SHADES[0];
+    }
+    return SHADES[std::min<size_t>(SHADES.size() - 1, 1 + (count - 1) * (SHADES.size() - 1) / area)];
+}
+
+DensityMap computeDensity(const Snapshot& snapshot, const int blockSize, ThreadPool& pool) {
+    DensityMap map;
+    map.blockSize = std::max(blockSize, 1);
+    map.rows = (snapshot.rows + map.blockSize - 1) / map.blockSize;
+    map.cols = (snapshot.cols + map.blockSize - 1) / map.blockSize;
+    map.counts.assign(static_cast<size_t>(map.rows) * map.cols, 0);
+
+    // block rows write disjoint parts of the map, so bands need no synchronization
+    pool.parallelFor(map.rows, 1, [&](const size_t begin, const size_t end) {
+        for (size_t blockRow = begin; blockRow < end; blockRow++) {
+            if (map.blockSize == 8) {
+                countBlocks8(snapshot, map, static_cast<int>(blockRow));
+            } else {
+                countBlocks(snapshot, map, static_cast<int>(blockRow));
+            }
+        }
+    });
+    return map;
+}
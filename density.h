@@ -0,0 +1,37 @@
+#ifndef DENSITY_H
+#define DENSITY_H
+
+#include <cstdint>
+#include <vector>
+#include "snapshot.h"
+#include "threadpool.h"
+
+/*
+ * DensityMap - number of live cells in each blockSize x blockSize square of a grid.
+ *
+ * Blocks at the right and bottom edges may be partial and only count the cells
+ * they cover.
+ */
+struct DensityMap {
+    int blockSize {};
+    int rows      {};                           // blocks down
+    int cols      {};                           // blocks across
+    std::vector<uint32_t> counts;               // live cells, row by row
+
+    uint32_t at(const int row, const int col) const {
+        return counts[static_cast<size_t>(row) * cols + col];
+    }
+};
+
+// counts the live cells of every block of a packed snapshot, one band of block rows
+// per batch on the pool; 8x8 blocks take a byte-wise popcount path
+DensityMap computeDensity(const Snapshot& snapshot, int blockSize, ThreadPool& pool);
+
+// live cells of one row of a packed snapshot in columns [begin, end)
+uint32_t countCells(const Snapshot& snapshot, int row, int begin, int end);
+
+// character for a block with count live cells out of area, from ' ' for an empty block
+// to '@' for a full one; any live cell shows, so sparse blocks do not vanish
+char densityShade(uint32_t count, uint32_t area);
+
+#endif
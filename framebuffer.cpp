@@ -0,0 +1,15 @@
+#include <iostream>
+#include "framebuffer.h"
+#include "terminal.h"
+
+void FrameBuffer::begin() {
+    started = std::chrono::steady_clock::now();
+    bytes.clear();
+    bytes.append("\033[1;1H");
+}
+
+bool FrameBuffer::flush() {
+    buildTime = std::chrono::steady_clock::now() - started;
+    std::cout.flush();  // prompts and messages printed before the frame stay before it
+    return writeFrame(bytes);
+}
@@ -0,0 +1,60 @@
+#ifndef FRAMEBUFFER_H
+#define FRAMEBUFFER_H
+
+#include <charconv>
+#include <chrono>
+#include <concepts>
+#include <string>
+#include <string_view>
+
+/*
+ * FrameBuffer - builds a frame of terminal output in memory and writes it at once.
+ *
+ * Text is appended to a byte buffer whose capacity is kept from frame to frame, so
+ * once it has grown to the size of a frame (or was reserved for it after a resize)
+ * building one allocates nothing. The whole frame then goes out in a single write(),
+ * bypassing the synchronized stdio streams, and the time it took to build is kept
+ * for the statistics.
+ */
+class FrameBuffer {
+    std::string bytes;                          // frame being built
+    std::chrono::steady_clock::time_point started;
+    std::chrono::nanoseconds buildTime {};      // of the last frame written
+
+public:
+    // starts a frame at the top left corner of the screen
+    void begin();
+
+    // keeps room for frames of up to size bytes
+    void reserve(const size_t size) {
+        bytes.reserve(size);
+    }
+
+    FrameBuffer& operator<<(const std::string_view text) {
+        bytes.append(text);
+        return *this;
+    }
+
+    FrameBuffer& operator<<(const char c) {
+        bytes.push_back(c);
+        return *this;
+    }
+
+    template<std::integral T>
+    FrameBuffer& operator<<(const T value) {
+        char digits[24];
+        const auto end = std::to_chars(digits, digits + sizeof(digits), value).ptr;
+        bytes.append(digits, end);
+        return *this;
+    }
+
+    // writes the frame after any output still buffered in std::cout, returns false on error
+    bool flush();
+
+    // time spent building the last frame written, from begin() to flush()
+    std::chrono::nanoseconds getBuildTime() const {
+        return buildTime;
+    }
+};
+
+#endif
@@ -0,0 +1,19 @@
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include "census.h"
+
+/*
+ * fuzz_census - libFuzzer harness for census files read by census_merge.
+ *
+ * Build: clang++ -std=c++23 -g -O1 -fsanitize=fuzzer,address,undefined fuzz_census.cpp census.cpp
+ */
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, const size_t size) {
+    std::istringstream in(std::string(reinterpret_cast<const char*>(data), size));
+    CensusReader reader(in);
+    while (reader.next()) {
+    }
+    reader.failed();
+    return 0;
+}
@@ -0,0 +1,18 @@
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include "checkpoint.h"
+
+/*
+ * fuzz_checkpoint - libFuzzer harness for checkpoints given to --resume.
+ *
+ * Build: clang++ -std=c++23 -g -O1 -fsanitize=fuzzer,address,undefined fuzz_checkpoint.cpp checkpoint.cpp
+ * Inputs are parsed with the default limits, which bound every allocation.
+ */
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, const size_t size) {
+    std::istringstream in(std::string(reinterpret_cast<const char*>(data), size));
+    Checkpoint checkpoint;
+    readCheckpoint(in, checkpoint);
+    return 0;
+}
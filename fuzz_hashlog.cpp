@@ -0,0 +1,17 @@
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include "hashlog.h"
+
+/*
+ * fuzz_hashlog - libFuzzer harness for hash logs given to --verify.
+ *
+ * Build: clang++ -std=c++23 -g -O1 -fsanitize=fuzzer,address,undefined fuzz_hashlog.cpp hashlog.cpp
+ */
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, const size_t size) {
+    std::istringstream in(std::string(reinterpret_cast<const char*>(data), size));
+    HashLog hashes;
+    readHashLog(in, hashes);
+    return 0;
+}
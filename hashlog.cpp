@@ -0,0 +1,35 @@
+#include <string>
+#include "hashlog.h"
+#include "textio.h"
+
+namespace {
+
+constexpr size_t MAX_HASH_LOG_LINE {128};       // "seed,generation,hash" with room for comments
+constexpr size_t MAX_HASH_LOG_ENTRIES {1 << 22};    // about 256 MB of map nodes
+
+} // namespace
+
+bool readHashLog(std::istream& in, HashLog& hashes) {
+    std::string line;
+    while (readLine(in, line, MAX_HASH_LOG_LINE)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        const auto first  = line.find(',');
+        const auto second = line.find(',', first + 1);
+        if (first == std::string::npos || second == std::string::npos) {
+            return false;
+        }
+        if (hashes.size() == MAX_HASH_LOG_ENTRIES) {
+            return false;
+        }
+        try {
+            const uint64_t seed = std::stoull(line.substr(0, first));
+            const int generation = std::stoi(line.substr(first + 1, second - first - 1));
+            hashes[{seed, generation}] = std::stoull(line.substr(second + 1), nullptr, 16);
+        } catch (const std::exception&) {
+            return false;
+        }
+    }
+    return !in.bad() && !hashes.empty();
+}
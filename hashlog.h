@@ -0,0 +1,17 @@
+#ifndef HASHLOG_H
+#define HASHLOG_H
+
+#include <cstdint>
+#include <istream>
+#include <map>
+#include <utility>
+
+// state hashes of a soup search keyed by (seed, generation)
+using HashLog = std::map<std::pair<uint64_t, int>, uint64_t>;
+
+// parses "seed,generation,hash" lines with the hash in hex, skipping comments; returns
+// false if a line is malformed or too long, the log has more entries than any run
+// writes, or it has none
+bool readHashLog(std::istream& in, HashLog& hashes);
+
+#endif
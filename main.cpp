@@ -4,14 +4,57 @@
 #include <cstdlib>          // for random number generation
 #include <ctime>            // for random number generation
 #include <chrono>           // for delays
-#include <thread>           // for delays
+#include <thread>           // for delays and parallel stepping
+#include <atomic>           // for band progress in parallel stepping
+#include <algorithm>        // for clamping
 #include <sys/ioctl.h>      // for terminal size
 #include <unistd.h>         // for terminal size
 #include <unordered_map>    // for generation history
+#include <random>           // for seeded soups
+#include <cstdint>          // for soup seeds and state hashes
+#include <fstream>          // for hash logs
+#include <climits>          // for bounding boxes
+#include <cstdio>           // for parsing option values
+#include <csignal>          // for graceful shutdown
+#include <bit>              // for placing pattern bitmaps
+#include <cerrno>           // for waiting on soup workers
+#include <sys/wait.h>       // for soup worker processes
+#include <tuple>            // for ranking methuselahs
 #include "patterns.h"       // contains predefined patterns
+#include "census.h"         // counts objects left by soups
+#include "snapshot.h"       // hands generations to concurrent consumers
+#include "threadpool.h"     // runs batches of universes
+#include "terminal.h"       // key presses for editing
+#include "soupring.h"       // soups shared with worker processes
+#include "density.h"        // block populations for heatmaps
+#include "oscillator.h"     // components of detected loops
+#include "analytics.h"      // entropy and correlation time series
+#include "checkpoint.h"     // parses checkpoints within size limits
+#include "textio.h"         // line reads with a length limit
+#include "soupmodel.h"      // predicts how long soups take
+#include "dashboard.h"      // tiles universes on the terminal
+#include "framebuffer.h"    // frames written with one write()
+#include "remote.h"         // streams generations to remote viewers
+#include "hashlog.h"        // reference hash logs within size limits
 
 
 
+// set by SIGINT and SIGTERM; the simulation loops check it and stop cleanly
+std::atomic<bool> stopRequested {false};
+static_assert(std::atomic<bool>::is_always_lock_free, "the flag is written by a signal handler");
+
+extern "C" void requestStop(int) {
+    stopRequested.store(true, std::memory_order_relaxed);
+}
+
+// counts SIGWINCH; displays compare it with the count they last fitted to
+std::atomic<int> terminalResizes {0};
+static_assert(std::atomic<int>::is_always_lock_free, "the count is written by a signal handler");
+
+extern "C" void noteResize(int) {
+    terminalResizes.fetch_add(1, std::memory_order_relaxed);
+}
+
 /*
  * GameOfLife - Main class that implements cellular automaton.
  *
@@ -23,11 +66,24 @@
  */
 class GameOfLife {
     static constexpr std::string ALIVE_CHAR {"■"};      // for displaying ALIVE cells
-    static constexpr std::string DEAD_CHAR  {' '};      // for displaying DEAD cells
     static constexpr bool ALIVE            {true};      // state of ALIVE cells
     static constexpr bool DEAD            {false};      // state of DEAD cells
     static constexpr int  DELAY_MS          {100};      // delay in milliseconds between generations
     static constexpr int  MAX_GENERATIONS {10000};      // maximum limit of generations
+    static constexpr int  ESCAPE_INTERVAL    {16};      // generations between escaping spaceship checks
+    static constexpr int  ESCAPE_MARGIN       {4};      // gap between a spaceship and other cells before removal
+    static constexpr int  MIN_SHIP_CELLS      {5};      // smaller objects are never examined as spaceships
+    static constexpr int  MAX_SHIP_CELLS     {32};      // neither are larger ones
+    static constexpr int  STOP_CHECK_INTERVAL {256};    // generations advanced between stop checks
+
+    // bytes of each kind of cell on screen, two columns wide, looked up once per cell
+    static constexpr std::string_view ALIVE_CELL  {"■ "};
+    static constexpr std::string_view DEAD_CELL   {"  "};
+    static constexpr std::string_view DIED_CELL   {"\033[31m■\033[0m "};  // last alive before extinction, in red
+    static constexpr std::string_view CURSOR_ALIVE {"\033[7m■\033[0m "}; // edit cursor in inverted colors
+    static constexpr std::string_view CURSOR_DEAD  {"\033[7m \033[0m "};
+    static constexpr size_t MAX_CELL_BYTES    {DIED_CELL.size()};
+    static constexpr size_t FRAME_TEXT_BYTES  {1024};   // status and help lines below the cells
 
     std::vector<std::vector<bool>> grid;        // current state of the grid
     std::vector<std::vector<bool>> lastDead;    // cells that died in the last generation
@@ -39,8 +95,40 @@ class GameOfLife {
     int totalDeaths            {};              // total number of cells that died
     int loopLength             {};              // length of detected loop (-1=extinction)
     float aliveProbability {0.2f};              // probability of a cell to be alive
+    int hashInterval           {};              // generations between state hashes (0=off)
+    int publishInterval        {};              // generations between published snapshots
+    bool paused                {};              // simulation paused for editing
+    int cursorRow              {};              // position of the edit cursor
+    int cursorCol              {};
+    int viewTop                {};              // first row and column on the screen
+    int viewLeft               {};
+    int viewRows               {};              // rows and columns that fit on the terminal
+    int viewCols               {};
+    int fittedResizes         {-1};             // terminalResizes when the view was last fitted
+    FrameBuffer frame;                          // interactive display, sized to the view
+    bool loaded                {};              // state was restored from a checkpoint
+    int orientation            {};              // of the pattern, see PatternShape
+    std::string checkpointPath {"gameoflife.checkpoint"};  // written when interrupted
+    SnapshotPublisher* publisher {};            // receives snapshots for concurrent consumers
     Pattern pattern;                            // selected pattern
-    std::unordered_map<std::string, int> generationHistory;
+    std::unordered_map<uint64_t, int> generationHistory;    // state key -> last generation with it
+    std::vector<bool> changedRows;              // rows changed by the last step or by edits
+    std::vector<bool> unkeyedRows;              // rows changed since their key was computed
+    std::vector<uint64_t> rowKeys;              // Zobrist key of each row
+    uint64_t stateKey {};                       // XOR of the row keys
+    std::vector<std::pair<int, uint64_t>> stateHashes;  // (generation, hash) checkpoints
+
+    // statistics of one thread of parallel stepping, each on its own cache line so that
+    // threads never write to a line another thread uses
+    struct alignas(64) ThreadStats {
+        long long births {};                    // cells born in the band of the thread
+        long long deaths {};                    // cells died in the band of the thread
+        std::chrono::nanoseconds busy    {};    // time spent computing
+        std::chrono::nanoseconds waiting {};    // time spent waiting for neighboring bands
+        int firstRow {};                        // rows of the band
+        int lastRow  {};
+    };
+    std::vector<ThreadStats> threadStats;       // per-thread statistics of the last advance()
 
     static std::pair<int, int> getTerminalSize() {
         struct winsize size{};
@@ -50,8 +138,35 @@ class GameOfLife {
         return {size.ws_row - 5, size.ws_col / 2};
     }
 
+    // resizes the view after the terminal changed and scrolls it so the edit cursor stays
+    // on screen; the board itself is never resized, only what is shown of it
+    void fitView() {
+        const int resizes = terminalResizes.load(std::memory_order_relaxed);
+        if (resizes != fittedResizes) {
+            fittedResizes = resizes;
+            const auto [fitRows, fitCols] = viewSize(rows, cols);
+            viewRows = fitRows;
+            viewCols = fitCols;
+            frame.reserve(frameBytes(viewRows, viewCols));
+            clearScreen();  // a smaller frame would leave parts of the old one
+        }
+        if (paused) {
+            if ((cursorRow - viewTop + rows) % rows >= viewRows) {
+                viewTop = (cursorRow - viewRows / 2 + rows) % rows;
+            }
+            if ((cursorCol - viewLeft + cols) % cols >= viewCols) {
+                viewLeft = (cursorCol - viewCols / 2 + cols) % cols;
+            }
+        }
+    }
+
     // counts the number of alive neighbors for a given cell
     int countAliveNeighbors(const int row, const int col) const {
+        return countAliveNeighbors(grid, row, col);
+    }
+
+    // counts the number of alive neighbors for a given cell of another buffer
+    int countAliveNeighbors(const std::vector<std::vector<bool>>& source, const int row, const int col) const {
         int count = 0;
 
         // check all 8 possible neighbors
@@ -63,7 +178,7 @@ class GameOfLife {
                 const int neighborRow = (row + dRow + rows) % rows;
                 const int neighborCol = (col + dCol + cols) % cols;
 
-                if (grid[neighborRow][neighborCol] == ALIVE) {
+                if (source[neighborRow][neighborCol] == ALIVE) {
                     count++;
                 }
             }
@@ -72,50 +187,217 @@ class GameOfLife {
         return count;
     }
 
-    // converts the grid to string for loop detection
-    std::string serializeGrid() const {
-        std::string result;
-        for (const auto& row : grid) {
-            for (bool cell : row) {
-                result.push_back(cell ? '1' : '0');
+    // Zobrist key of a cell, a fixed random-looking value XORed into the key of its row
+    // while the cell is alive (splitmix64 of the cell index)
+    uint64_t cellKey(const int row, const int col) const {
+        uint64_t key = (static_cast<uint64_t>(row) * cols + col + 1) * 0x9e3779b97f4a7c15ull;
+        key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ull;
+        key = (key ^ (key >> 27)) * 0x94d049bb133111ebull;
+        return key ^ (key >> 31);
+    }
+
+    // brings the key of the board up to date for loop detection, rekeying only the rows
+    // that changed since the last call, so a step costs in proportion to its active rows
+    uint64_t updateStateKey() {
+        for (int i = 0; i < rows; i++) {
+            if (!unkeyedRows[i] && !changedRows[i]) continue;
+            uint64_t key = 0;
+            for (int j = 0; j < cols; j++) {
+                if (grid[i][j] == ALIVE) {
+                    key ^= cellKey(i, j);
+                }
             }
+            stateKey ^= rowKeys[i] ^ key;
+            rowKeys[i] = key;
         }
-        return result;
+        unkeyedRows.assign(rows, false);
+        return stateKey;
     }
 
-    // displays the loop or extinction message on the screen
-    void displayState() const {
+    // adds the loop or extinction message to the frame
+    void displayState() {
         std::string message;
 
         if (loopLength > 0) {
             message = "LOOP DETECTED (IN GENERATION: " +
-                std::to_string(generationHistory.size()) + ")";
+                std::to_string(generation) + ")";
         } else if (loopLength == -1) {
             message = "ALL CELLS HAVE DIED (IN GENERATION: " +
-                std::to_string(generationHistory.size()) + ")";
+                std::to_string(generation) + ")";
         } else {
             return;
         }
 
         int messageLength = static_cast<int>(message.length());
-        int centerRow = rows / 6;
-        int startCol = (cols - messageLength / 2);
+        int centerRow = viewRows / 6;
+        int startCol = (viewCols - messageLength / 2);
 
-        std::cout << "\033[s";  // save cursor position
-        std::cout << "\033[" << centerRow << ";" << startCol << "H";
-        std::cout << "\033[7m " << message << " \033[0m"; // invert the colors
-        std::cout << "\033[u";  // restore cursor position
-        std::cout.flush();
+        frame << "\033[s";  // save cursor position
+        frame << "\033[" << centerRow << ";" << startCol << "H";
+        frame << "\033[7m " << message << " \033[0m"; // invert the colors
+        frame << "\033[u";  // restore cursor position
     }
 
-public:
-    // constructor
-    GameOfLife() {
-        auto [termRows, termCols] = getTerminalSize();
-        rows = termRows;
-        cols = termCols;
+    // clears the grid and all statistics
+    void reset() {
         grid     = std::vector<std::vector<bool>>(rows, std::vector<bool>(cols, DEAD));
         lastDead = std::vector<std::vector<bool>>(rows, std::vector<bool>(cols, DEAD));
+        changedRows.assign(rows, true);
+        unkeyedRows.assign(rows, true);
+        rowKeys.assign(rows, 0);
+        stateKey          = 0;
+        generation        = 0;
+        currentAliveCells = 0;
+        totalBirths       = 0;
+        totalDeaths       = 0;
+        loopLength        = 0;
+        generationHistory.clear();
+        stateHashes.clear();
+    }
+
+    // hands the current generation to the consumers every publishInterval generations
+    void publish() {
+        if (publisher != nullptr && generation % publishInterval == 0) {
+            publisher->publish(grid, generation, currentAliveCells, totalBirths, totalDeaths);
+        }
+    }
+
+    // hashes the grid every hashInterval generations in determinism mode
+    void recordStateHash() {
+        if (hashInterval > 0 && generation % hashInterval == 0) {
+            stateHashes.emplace_back(generation, hashState());
+        }
+    }
+
+    // splits alive cells into 8-connected objects, coordinates are unwrapped across edges
+    std::vector<std::vector<std::pair<int, int>>> findObjects() const {
+        std::vector<std::vector<bool>> visited(rows, std::vector<bool>(cols, false));
+        std::vector<std::vector<std::pair<int, int>>> objects;
+
+        for (int i = 0; i < rows; i++) {
+            for (int j = 0; j < cols; j++) {
+                if (grid[i][j] != ALIVE || visited[i][j]) continue;
+
+                std::vector<std::pair<int, int>> object;
+                std::vector<std::pair<int, int>> stack {{i, j}};
+                visited[i][j] = true;
+
+                while (!stack.empty()) {
+                    const auto [row, col] = stack.back();
+                    stack.pop_back();
+                    object.emplace_back(row, col);
+
+                    for (int dRow = -1; dRow <= 1; dRow++) {
+                        for (int dCol = -1; dCol <= 1; dCol++) {
+                            const int r = ((row + dRow) % rows + rows) % rows;
+                            const int c = ((col + dCol) % cols + cols) % cols;
+                            if (grid[r][c] == ALIVE && !visited[r][c]) {
+                                visited[r][c] = true;
+                                stack.emplace_back(row + dRow, col + dCol);
+                            }
+                        }
+                    }
+                }
+                objects.push_back(std::move(object));
+            }
+        }
+        return objects;
+    }
+
+    // shifts an object by whole board sizes so that its bounding box starts in the board
+    // size after (top, left); objects crossing a torus edge then get the same coordinates
+    // whichever of their cells findObjects reached first
+    void anchorObject(std::vector<std::pair<int, int>>& object, const int top, const int left) const {
+        int minRow = INT_MAX, minCol = INT_MAX;
+        for (const auto& [row, col] : object) {
+            minRow = std::min(minRow, row);
+            minCol = std::min(minCol, col);
+        }
+        const int shiftRow = ((minRow - top) % rows + rows) % rows - (minRow - top);
+        const int shiftCol = ((minCol - left) % cols + cols) % cols - (minCol - left);
+        for (auto& [row, col] : object) {
+            row += shiftRow;
+            col += shiftCol;
+        }
+    }
+
+    // removes spaceships that left the other cells behind and move away from them, before
+    // they wrap around the torus and collide; removed ships are appended to escaped.
+    // Ships are placed below and right of the other cells, so one moving up or left
+    // away from them is measured from their far side across the torus edge
+    int removeEscapingShips(std::vector<std::vector<std::pair<int, int>>>& escaped) {
+        auto objects = findObjects();
+        for (auto& object : objects) {
+            anchorObject(object, 0, 0);
+        }
+        std::vector<Motion> motions(objects.size());
+
+        // bounding box of all cells that are not part of a spaceship
+        int top = INT_MAX, bottom = INT_MIN, left = INT_MAX, right = INT_MIN;
+        for (size_t k = 0; k < objects.size(); k++) {
+            if (objects[k].size() >= MIN_SHIP_CELLS && objects[k].size() <= MAX_SHIP_CELLS) {
+                motions[k] = objectMotion(objects[k]);
+            }
+            if (motions[k].dRow != 0 || motions[k].dCol != 0) continue;
+
+            for (const auto& [row, col] : objects[k]) {
+                top    = std::min(top, row);
+                bottom = std::max(bottom, row);
+                left   = std::min(left, col);
+                right  = std::max(right, col);
+            }
+        }
+
+        int removed = 0;
+        for (size_t k = 0; k < objects.size(); k++) {
+            const auto [period, dRow, dCol] = motions[k];
+            if (dRow == 0 && dCol == 0) continue;
+
+            if (top != INT_MAX) {
+                anchorObject(objects[k], top, left);
+            }
+            int shipTop = INT_MAX, shipBottom = INT_MIN, shipLeft = INT_MAX, shipRight = INT_MIN;
+            for (const auto& [row, col] : objects[k]) {
+                shipTop    = std::min(shipTop, row);
+                shipBottom = std::max(shipBottom, row);
+                shipLeft   = std::min(shipLeft, col);
+                shipRight  = std::max(shipRight, col);
+            }
+
+            // the gap between the far side of the other cells and their near side one
+            // board size further, which the ship must be in
+            const bool rowGap = shipTop > bottom && shipBottom < top + rows;
+            const bool colGap = shipLeft > right && shipRight < left + cols;
+            const bool escaping = top == INT_MAX ||     // only spaceships are left
+                (dRow > 0 && rowGap && shipTop    > bottom + ESCAPE_MARGIN) ||
+                (dRow < 0 && rowGap && shipBottom < top + rows - ESCAPE_MARGIN) ||
+                (dCol > 0 && colGap && shipLeft   > right + ESCAPE_MARGIN) ||
+                (dCol < 0 && colGap && shipRight  < left + cols - ESCAPE_MARGIN);
+            if (!escaping) continue;
+
+            for (const auto& [row, col] : objects[k]) {
+                const int r = (row % rows + rows) % rows;
+                grid[r][(col % cols + cols) % cols] = DEAD;
+                changedRows[r] = true;
+                currentAliveCells--;
+            }
+            escaped.push_back(objects[k]);
+            removed++;
+        }
+
+        if (removed > 0) {
+            generationHistory.clear();  // earlier states still contain the removed ships
+        }
+        return removed;
+    }
+
+public:
+    // constructor
+    GameOfLife() : GameOfLife(getTerminalSize().first, getTerminalSize().second) {}
+
+    // constructor for a grid of given size, used without a terminal
+    GameOfLife(const int rows, const int cols) : rows(rows), cols(cols) {
+        reset();
     }
 
     static void clearScreen() {
@@ -134,8 +416,18 @@ public:
         std::cout << "\033[?25h";   // show cursor after simulation
     }
 
+    // selects one of the predefined patterns without asking
+    void selectPattern(const size_t index) {
+        pattern = PATTERNS[index].toPattern();
+    }
+
+    // rotates or mirrors the pattern placed by setPattern, see PatternShape
+    void setOrientation(const int value) {
+        orientation = value;
+    }
+
     void selectPattern() {
-        while (true) {
+        while (!stopRequested) {
             std::cout << "Select an initial pattern. Available patterns:\n";
             std::cout << "0. " << PATTERNS[0].name << "\n";
 
@@ -154,25 +446,54 @@ public:
                 std::cin.ignore(1000, '\n');
                 std::cout << "Invalid input. Please try again.\n";
             } else {
-                pattern = PATTERNS[choice];
+                pattern = PATTERNS[choice].toPattern();
                 break;
             }
         }
     }
 
+    // sets the cells of a pattern bitmap centered at (centerRow, centerCol) on an empty grid;
+    // each run of set bits becomes one range fill of a row, split only where it wraps
+    void placeShape(const PatternBitmap& bitmap, const int centerRow, const int centerCol) {
+        for (int i = 0; i < bitmap.height; i++) {
+            auto& row = grid[((centerRow + bitmap.top + i) % rows + rows) % rows];
+            for (int w = 0; w < bitmap.wordsPerRow; w++) {
+                uint64_t bits = bitmap.words[static_cast<size_t>(i) * bitmap.wordsPerRow + w];
+                while (bits != 0) {
+                    const int start = std::countr_zero(bits);
+                    const int run   = std::countr_one(bits >> start);
+                    bits &= start + run == 64 ? 0 : ~0ull << (start + run);
+
+                    int col  = ((centerCol + bitmap.left + w * 64 + start) % cols + cols) % cols;
+                    int left = run;
+                    while (left > 0) {
+                        const int piece = std::min(left, cols - col);
+                        std::fill(row.begin() + col, row.begin() + col + piece, ALIVE);
+                        left -= piece;
+                        col = 0;
+                    }
+                }
+            }
+        }
+
+        if (bitmap.height <= rows && bitmap.width <= cols) {
+            currentAliveCells += pattern.shape.getPopulation();
+        } else {
+            // the pattern wraps onto itself, so some cells were set twice
+            currentAliveCells = 0;
+            for (const auto& row : grid) {
+                currentAliveCells += static_cast<int>(std::count(row.begin(), row.end(), ALIVE));
+            }
+        }
+    }
+
     void setPattern() {
         if (pattern.name != "Random") {
             // center pattern on the grid
             const auto centerRow = rows / 2;
             const auto centerCol = cols / 2;
 
-            // add each cell from the pattern
-            for (const auto& [rowOffset, colOffset] : pattern.cells) {
-                int r = (centerRow + rowOffset + rows) % rows;
-                int c = (centerCol + colOffset + cols) % cols;
-                grid[r][c] = ALIVE;
-                currentAliveCells++;
-            }
+            placeShape(pattern.shape.oriented(orientation), centerRow, centerCol);
         } else {
             // random initialization
             for (auto& row : grid) {
@@ -186,144 +507,1849 @@ public:
         }
     }
 
-    // renders the grid and statistics to the console
-    void displayGrid() const {
-        moveCursor();
-
-        for (int i = 0; i < rows; i++) {
-            for (int j = 0; j < cols; j++) {
-                if (grid[i][j] == ALIVE) {
-                    std::cout << ALIVE_CHAR << ' ';
-                } else if (loopLength == -1 && lastDead[i][j]) {
-                    std::cout << "\033[31m" << ALIVE_CHAR << "\033[0m "; // mark in red
-                } else {
-                    std::cout << DEAD_CHAR << ' ';
+    // fills the whole grid randomly with aliveProbability, reproducibly for a seed
+    void randomize(const uint64_t seed) {
+        reset();
+        std::mt19937_64 rng(seed);
+        std::bernoulli_distribution alive(aliveProbability);
+        for (auto& row : grid) {
+            for (auto cell : row) {
+                cell = alive(rng);
+                if (cell == ALIVE) {
+                    currentAliveCells++;
                 }
             }
-            std::cout << '\n';
         }
-        std::cout << "\nPattern: "          << pattern.name
-                  << " | Generation: "      << generation
-                  << " | Alive cells: "     << currentAliveCells
-                  << " | Total births: "    << totalBirths
-                  << " | Total deaths: "    << totalDeaths;
+        recordStateHash();
+    }
 
-        if (loopLength > 0) {
-            std::cout << " | State: Loop (period: " << loopLength << ")";
+    // writes the statistics line shown below the grid to a stream or a frame
+    template<typename Output>
+    void writeStatus(Output& out) const {
+        out << "Pattern: "            << pattern.name
+            << " | Generation: "      << generation
+            << " | Alive cells: "     << currentAliveCells
+            << " | Total births: "    << totalBirths
+            << " | Total deaths: "    << totalDeaths;
+
+        if (!stateHashes.empty()) {
+            out << " | Hash@" << stateHashes.back().first << ": "
+                << formatHash(stateHashes.back().second);
+        }
+
+        if (paused) {
+            out << " | State: Paused (editing)";
+        } else if (loopLength > 0) {
+            out << " | State: Loop (period: " << loopLength << ")";
         } else if (loopLength == -1) {
-            std::cout << " | State: Extinction";
+            out << " | State: Extinction";
         } else {
-            std::cout << " | State: Evolving";
+            out << " | State: Evolving";
         }
+    }
 
-        std::cout << "\nPress Ctrl+C to exit\n";
-        std::cout.flush();
+    // prints the statistics line shown below the grid
+    void printStatus() const {
+        writeStatus(std::cout);
+    }
+
+    // renders the part of the grid in view and statistics to the console, built in the
+    // frame buffer and written at once; the status shows how long the previous frame took
+    void displayGrid() {
+        frame.begin();
+
+        for (int vi = 0; vi < viewRows; vi++) {
+            const int i = (viewTop + vi) % rows;
+            for (int vj = 0; vj < viewCols; vj++) {
+                const int j = (viewLeft + vj) % cols;
+                if (paused && i == cursorRow && j == cursorCol) {
+                    frame << (grid[i][j] == ALIVE ? CURSOR_ALIVE : CURSOR_DEAD);
+                } else if (grid[i][j] == ALIVE) {
+                    frame << ALIVE_CELL;
+                } else if (loopLength == -1 && lastDead[i][j]) {
+                    frame << DIED_CELL;
+                } else {
+                    frame << DEAD_CELL;
+                }
+            }
+            frame << '\n';
+        }
+        frame << '\n';
+        writeStatus(frame);
+        frame << " | Frame: " << frame.getBuildTime().count() / 1000 << " us"
+              << "\nSpace: pause/resume | While paused: arrows move, X toggles a cell, N steps"
+              << " | Q or Ctrl+C: exit\n";
 
         if (loopLength != 0) {
             displayState();
         }
+        frame.flush();
     }
 
-    void computeNextGeneration() {
-        std::vector<std::vector<bool>> newGrid = grid;
-        lastDead = std::vector<std::vector<bool>>(rows, std::vector<bool>(cols, DEAD));
+    // computes the next state of the cells in a rectangle that wraps around the edges;
+    // cells outside of the rectangle keep their current state
+    void computeRegion(const int top, const int left, const int height, const int width) {
+        std::vector<std::vector<bool>> newRegion(height, std::vector<bool>(width, DEAD));
+
+        for (int i = 0; i < height; i++) {
+            for (int j = 0; j < width; j++) {
+                const int row = (top + i + rows) % rows;
+                const int col = (left + j + cols) % cols;
+                const int neighbors = countAliveNeighbors(row, col);
 
+                if (grid[row][col] == ALIVE) {
+                    // ALIVE cell stays alive with 2 or 3 neighbors, otherwise dies
+                    // due to underpopulation or overpopulation
+                    newRegion[i][j] = (neighbors == 2 || neighbors == 3);
+                } else {
+                    // DEAD cell becomes ALIVE due to reproduction
+                    newRegion[i][j] = (neighbors == 3);
+                }
+            }
+        }
+
+        for (int i = 0; i < height; i++) {
+            for (int j = 0; j < width; j++) {
+                const int row = (top + i + rows) % rows;
+                const int col = (left + j + cols) % cols;
+                const bool died = grid[row][col] == ALIVE && newRegion[i][j] == DEAD;
+
+                if (died) {
+                    totalDeaths++;
+                    currentAliveCells--;
+                    changedRows[row] = true;
+                } else if (grid[row][col] == DEAD && newRegion[i][j] == ALIVE) {
+                    totalBirths++;
+                    currentAliveCells++;
+                    changedRows[row] = true;
+                }
+                grid[row][col]     = newRegion[i][j];
+                lastDead[row][col] = died;
+            }
+        }
+    }
+
+    void computeNextGeneration() {
+        // a row can only change if it or a neighboring row changed in the last step
+        std::vector<bool> active(rows, false);
         for (int i = 0; i < rows; i++) {
-            for (int j = 0; j < cols; j++) {
-                const int neighbors = countAliveNeighbors(i, j);
+            if (changedRows[i]) {
+                unkeyedRows[i]                = true;   // until the next loop check
+                active[(i + rows - 1) % rows] = true;
+                active[i]                     = true;
+                active[(i + 1) % rows]        = true;
+            }
+        }
+        changedRows.assign(rows, false);
 
-                if (grid[i][j] == ALIVE) {
-                    // ALIVE cell
-                    if (neighbors < 2 || neighbors > 3) {
-                        // dies due to underpopulation or overpopulation
-                        newGrid[i][j]  =  DEAD;
-                        lastDead[i][j] = ALIVE;
-                        totalDeaths++;
-                        currentAliveCells--;
+        // compute each run of active rows as one region, starting after an inactive row
+        // so that no run wraps into one that was already written
+        int start = 0;
+        while (start < rows && active[start]) start++;
+        if (start == rows) {
+            computeRegion(0, 0, rows, cols);
+        }
+        for (int k = 0; start < rows && k < rows; ) {
+            if (!active[(start + k) % rows]) {
+                k++;
+                continue;
+            }
+            int end = k;
+            while (end < rows && active[(start + end) % rows]) end++;
+            computeRegion(start + k, 0, end - k, cols);
+            k = end;
+        }
+
+        generation++;
+        recordStateHash();
+        publish();
+    }
+
+    // flips a cell: only its row is marked for the next step, so resuming costs in
+    // proportion to the edit, and the loop history no longer describes this board
+    void toggleCell(const int row, const int col) {
+        grid[row][col] = !grid[row][col];
+        currentAliveCells += grid[row][col] == ALIVE ? 1 : -1;
+        lastDead[row][col] = DEAD;
+        changedRows[row] = true;
+        generationHistory.clear();
+        loopLength = 0;
+    }
+
+    // moves the edit cursor or toggles the cell under it
+    void handleEditKey(const int key) {
+        switch (key) {
+            case KEY_UP:    case 'k': cursorRow = (cursorRow + rows - 1) % rows; break;
+            case KEY_DOWN:  case 'j': cursorRow = (cursorRow + 1) % rows;        break;
+            case KEY_LEFT:  case 'h': cursorCol = (cursorCol + cols - 1) % cols; break;
+            case KEY_RIGHT: case 'l': cursorCol = (cursorCol + 1) % cols;        break;
+            case 'x': case 'X': case '\n': toggleCell(cursorRow, cursorCol);    break;
+            default: break;
+        }
+    }
+
+    // advances generations on several threads without a barrier per generation: the board
+    // is split into bands of rows and a band computes generation g+1 as soon as the bands
+    // above and below it have reached g. States alternate between two buffers by parity;
+    // a neighbor can be at most one generation apart, so a band never overwrites rows
+    // that another band still has to read.
+    //
+    // Generations to hash or publish, and every STOP_CHECK_INTERVAL-th one, are events:
+    // each band copies its rows of the event generation into a staging slot as it passes,
+    // and the last band to arrive hashes or publishes the slot and checks for a stop, so
+    // the bands never wait for each other at an event. Two slots alternate; a band only
+    // waits if it is a whole event ahead of the slowest one. A stop noticed at an event
+    // ends the run at the event after next, which every band reads only once it waited
+    // for its slot, so they all stop at the same generation
+    void advanceParallel(const int generations, const int threads) {
+        if (generations <= 0) return;
+
+        struct alignas(64) BandProgress {               // own cache line per band
+            std::atomic<int> generation {};             // generations completed by the band
+        };
+        struct EventSlot {
+            std::vector<std::vector<bool>> cells;       // rows copied in by each band
+            std::vector<long long> births;              // per band, since the start of the run
+            std::vector<long long> deaths;
+            std::atomic<int> arrived {};                // bands that copied their rows
+        };
+
+        const int bands = std::clamp(threads, 1, rows);
+        std::vector<std::vector<bool>> buffers[2] {grid, grid};
+        std::vector<BandProgress> progress(bands);
+        if (static_cast<int>(threadStats.size()) != bands) {
+            threadStats.assign(bands, ThreadStats{});
+        }
+
+        const int startGeneration = generation;
+        const auto isEvent = [&](const int g) {     // g generations into the run, before the end
+            const int absolute = startGeneration + g;
+            return (hashInterval > 0 && absolute % hashInterval == 0) ||
+                   (publisher != nullptr && absolute % publishInterval == 0) ||
+                   g % STOP_CHECK_INTERVAL == 0;
+        };
+        EventSlot slots[2];
+        for (EventSlot& slot : slots) {
+            slot.cells = grid;
+            slot.births.assign(bands, 0);
+            slot.deaths.assign(bands, 0);
+        }
+        std::atomic<int> committed {};              // events handled by their last band
+        std::atomic<int> stopEvent {INT_MAX};       // index of the event to stop at
+        std::atomic<int> done {generations};        // generations actually advanced
+
+        // runs on the last band to reach an event, after every band copied its rows
+        const auto commit = [&](EventSlot& slot, const int event, const int g) {
+            const int absolute = startGeneration + g;
+            long long births = 0, deaths = 0;
+            for (int band = 0; band < bands; band++) {
+                births += slot.births[band];
+                deaths += slot.deaths[band];
+            }
+            if (hashInterval > 0 && absolute % hashInterval == 0) {
+                stateHashes.emplace_back(absolute, hashState(slot.cells));
+            }
+            if (publisher != nullptr && absolute % publishInterval == 0) {
+                publisher->publish(slot.cells, absolute, currentAliveCells + static_cast<int>(births - deaths),
+                                   totalBirths + static_cast<int>(births), totalDeaths + static_cast<int>(deaths));
+            }
+            if (stopRequested && stopEvent.load(std::memory_order_relaxed) == INT_MAX) {
+                // published to the bands by the release below
+                stopEvent.store(event + 2, std::memory_order_relaxed);
+            }
+            slot.arrived.store(0, std::memory_order_relaxed);
+            committed.fetch_add(1, std::memory_order_release);
+            committed.notify_all();
+        };
+
+        const auto work = [&](const int band) {
+            using Clock = std::chrono::steady_clock;
+            const int first = band * rows / bands;
+            const int last  = (band + 1) * rows / bands;
+            ThreadStats& stats = threadStats[band];
+            stats.firstRow = first;
+            stats.lastRow  = last;
+            long long runBirths = 0;
+            long long runDeaths = 0;
+            int events = 0;
+
+            for (int g = 0; g < generations; g++) {
+                const auto waitStart = Clock::now();
+
+                // wait until the neighboring bands have reached generation g
+                for (const int neighbor : {(band + bands - 1) % bands, (band + 1) % bands}) {
+                    std::atomic<int>& reached = progress[neighbor].generation;
+                    for (int value = reached.load(std::memory_order_acquire); value < g;
+                         value = reached.load(std::memory_order_acquire)) {
+                        reached.wait(value, std::memory_order_acquire);
                     }
-                    // if neighbors is 2 or 3, cell stays alive (already ALIVE)
-                } else {
-                    // DEAD cell
-                    if (neighbors == 3) {
-                        // becomes ALIVE due to reproduction
-                        newGrid[i][j] = ALIVE;
-                        totalBirths++;
-                        currentAliveCells++;
+                }
+
+                const auto computeStart = Clock::now();
+                const auto& from = buffers[g % 2];
+                auto& to = buffers[(g + 1) % 2];
+                int births = 0;
+                int deaths = 0;
+                for (int i = first; i < last; i++) {
+                    for (int j = 0; j < cols; j++) {
+                        const int neighbors = countAliveNeighbors(from, i, j);
+                        const bool alive = from[i][j];
+                        const bool next = alive ? (neighbors == 2 || neighbors == 3) : neighbors == 3;
+
+                        to[i][j] = next;
+                        births += !alive && next;
+                        deaths += alive && !next;
+                    }
+                }
+
+                // counters are kept in registers and published once per generation
+                stats.births  += births;
+                stats.deaths  += deaths;
+                runBirths     += births;
+                runDeaths     += deaths;
+                stats.waiting += computeStart - waitStart;
+                stats.busy    += Clock::now() - computeStart;
+
+                progress[band].generation.store(g + 1, std::memory_order_release);
+                progress[band].generation.notify_all();
+
+                if (g + 1 < generations && isEvent(g + 1)) {
+                    // the slot is free once the event two before this one was handled
+                    for (int value = committed.load(std::memory_order_acquire); value < events - 1;
+                         value = committed.load(std::memory_order_acquire)) {
+                        committed.wait(value, std::memory_order_acquire);
+                    }
+                    if (events >= stopEvent.load(std::memory_order_relaxed)) {
+                        done.store(g + 1, std::memory_order_relaxed);
+                        return;
+                    }
+                    EventSlot& slot = slots[events % 2];
+                    for (int i = first; i < last; i++) {
+                        slot.cells[i] = to[i];
                     }
-                    // otherwise, cell stays DEAD (already DEAD)
+                    slot.births[band] = runBirths;
+                    slot.deaths[band] = runDeaths;
+                    if (slot.arrived.fetch_add(1, std::memory_order_acq_rel) == bands - 1) {
+                        commit(slot, events, g + 1);
+                    }
+                    events++;
                 }
             }
+        };
+
+        std::vector<ThreadStats> before = threadStats;
+        {
+            std::vector<std::jthread> workers;
+            for (int band = 0; band < bands; band++) {
+                workers.emplace_back(work, band);
+            }
         }
 
-        grid = newGrid;
-        generation++;
+        // single reduction of the per-thread counters after all bands finished
+        const int advanced = done.load(std::memory_order_relaxed);
+        const auto& previous = buffers[(advanced + 1) % 2];
+        grid = std::move(buffers[advanced % 2]);
+        for (int i = 0; i < rows; i++) {
+            for (int j = 0; j < cols; j++) {
+                lastDead[i][j] = previous[i][j] && !grid[i][j];
+            }
+        }
+        for (int band = 0; band < bands; band++) {
+            const long long births = threadStats[band].births - before[band].births;
+            const long long deaths = threadStats[band].deaths - before[band].deaths;
+            totalBirths       += static_cast<int>(births);
+            totalDeaths       += static_cast<int>(deaths);
+            currentAliveCells += static_cast<int>(births - deaths);
+        }
+        changedRows.assign(rows, true);
+        generation += advanced;
+        recordStateHash();
+        publish();
     }
 
-    // check if all cells in the grid are dead
-    bool areAllDead() const {
-        for (const auto& row : grid) {
-            for (bool cell : row) {
-                if (cell == ALIVE) {
-                    return false;  // found a live cell
+    // advances the given number of generations computing only the backward light cone
+    // of the region: a cell influences its neighbors one generation later, so only cells
+    // within generations-g-1 of the region matter for step g. Cells outside of the cone
+    // are left stale and loop detection is skipped
+    void advanceRegion(const int top, const int left, const int height, const int width,
+                       const int generations) {
+        for (int g = 0; g < generations; g++) {
+            const int reach = generations - g - 1;
+            const int coneHeight = height + 2 * reach;
+            const int coneWidth  = width  + 2 * reach;
+
+            computeRegion(coneHeight >= rows ? 0 : top - reach,
+                          coneWidth  >= cols ? 0 : left - reach,
+                          std::min(coneHeight, rows),
+                          std::min(coneWidth, cols));
+            generation++;
+            recordStateHash();
+        }
+        changedRows.assign(rows, true);     // cells outside of the cone are stale
+    }
+
+    // prints the cells of a rectangle, one row per line
+    void printRegion(const int top, const int left, const int height, const int width) const {
+        std::cout << "Pattern: "       << pattern.name
+                  << " | Generation: " << generation
+                  << " | Region: "     << height << "x" << width << " at " << top << "," << left << "\n";
+
+        for (int i = 0; i < height; i++) {
+            for (int j = 0; j < width; j++) {
+                const bool cell = grid[(top + i + rows) % rows][(left + j + cols) % cols];
+                std::cout << (cell == ALIVE ? ALIVE_CHAR : std::string(".")) << ' ';
+            }
+            std::cout << '\n';
+        }
+    }
+
+    // hash of the grid that depends only on its contents, never on the host or the
+    // memory layout: FNV-1a over the size and each row packed into bytes, LSB first
+    uint64_t hashState() const {
+        return hashState(grid);
+    }
+
+    // the same hash of another buffer of this board's size
+    uint64_t hashState(const std::vector<std::vector<bool>>& cells) const {
+        uint64_t hash = 14695981039346656037ull;
+        const auto mix = [&hash](const uint64_t byte) {
+            hash ^= byte;
+            hash *= 1099511628211ull;
+        };
+
+        for (const int value : {rows, cols}) {
+            for (int shift = 0; shift < 32; shift += 8) {
+                mix((static_cast<uint32_t>(value) >> shift) & 0xff);
+            }
+        }
+        for (const auto& row : cells) {
+            uint64_t byte = 0;
+            for (int j = 0; j < cols; j++) {
+                byte |= static_cast<uint64_t>(row[j]) << (j % 8);
+                if (j % 8 == 7 || j == cols - 1) {
+                    mix(byte);
+                    byte = 0;
                 }
             }
         }
-        return true;  // no live cells found
+        return hash;
     }
 
-    // checks if all cells are dead or loop is detected
+    // advances generations on several threads; hashes and publications happen at the same
+    // generations as in single-threaded stepping, and a stop request ends the run early
+    void advance(const int generations, const int threads) {
+        threadStats.clear();
+        if (!stopRequested) {
+            advanceParallel(generations, threads);
+        }
+    }
+
+    // prints the per-thread statistics of the last advance(), one line per thread,
+    // with the slowest thread's busy time relative to the average to show imbalance
+    void printThreadStats() const {
+        if (threadStats.empty()) return;
+
+        using Milliseconds = std::chrono::duration<double, std::milli>;
+        Milliseconds total {};
+        Milliseconds slowest {};
+        for (size_t k = 0; k < threadStats.size(); k++) {
+            const ThreadStats& stats = threadStats[k];
+            const Milliseconds busy = stats.busy;
+            total  += busy;
+            slowest = std::max(slowest, busy);
+            std::cout << "Thread " << k
+                      << " | Rows: "    << stats.firstRow << "-" << stats.lastRow - 1
+                      << " | Births: "  << stats.births
+                      << " | Deaths: "  << stats.deaths
+                      << " | Busy: "    << busy.count() << " ms"
+                      << " | Waiting: " << Milliseconds(stats.waiting).count() << " ms\n";
+        }
+
+        const double average = total.count() / static_cast<double>(threadStats.size());
+        std::cout << "Load imbalance (slowest / average busy time): "
+                  << (average > 0 ? slowest.count() / average : 1.0) << "\n";
+    }
+
+    // publishes the grid every interval generations, nullptr stops publishing
+    void setPublisher(SnapshotPublisher* target, const int interval) {
+        publisher = target;
+        publishInterval = std::max(interval, 1);
+        publish();
+    }
+
+    // part of a rows x cols board (or heatmap) that fits on the terminal
+    static std::pair<int, int> viewSize(const int rows, const int cols) {
+        const auto [terminalRows, terminalCols] = getTerminalSize();
+        return {std::clamp(terminalRows, 1, rows), std::clamp(terminalCols, 1, cols)};
+    }
+
+    // bytes a frame of viewRows x viewCols cells can take, for reserving frame buffers
+    static size_t frameBytes(const int viewRows, const int viewCols) {
+        return static_cast<size_t>(viewRows) * (static_cast<size_t>(viewCols) * MAX_CELL_BYTES + 1) +
+               FRAME_TEXT_BYTES;
+    }
+
+    // renders the top left viewRows x viewCols of a published snapshot, used by consumers
+    // running beside the engine
+    static void displaySnapshot(FrameBuffer& frame, const Snapshot& snapshot, const std::string& name,
+                                const int viewRows, const int viewCols) {
+        frame.begin();
+
+        for (int i = 0; i < std::min(viewRows, snapshot.rows); i++) {
+            for (int j = 0; j < std::min(viewCols, snapshot.cols); j++) {
+                frame << (snapshot.get(i, j) ? ALIVE_CELL : DEAD_CELL);
+            }
+            frame << '\n';
+        }
+        frame << "\nPattern: "          << name
+              << " | Generation: "      << snapshot.generation
+              << " | Alive cells: "     << snapshot.aliveCells
+              << " | Total births: "    << snapshot.totalBirths
+              << " | Total deaths: "    << snapshot.totalDeaths
+              << " | Frame: "           << frame.getBuildTime().count() / 1000 << " us\n";
+        frame.flush();
+    }
+
+    // renders a snapshot as a heatmap, two characters per block of its density map,
+    // for boards too large to show cell by cell; only the top left viewRows x viewCols
+    // blocks are shown
+    static void displayDensity(FrameBuffer& frame, const Snapshot& snapshot, const DensityMap& density,
+                               const std::string& name, const int viewRows, const int viewCols) {
+        const uint32_t area = static_cast<uint32_t>(density.blockSize * density.blockSize);
+        frame.begin();
+
+        for (int i = 0; i < std::min(viewRows, density.rows); i++) {
+            for (int j = 0; j < std::min(viewCols, density.cols); j++) {
+                const char shade = densityShade(density.at(i, j), area);
+                frame << shade << shade;
+            }
+            frame << '\n';
+        }
+        frame << "\nPattern: "          << name
+              << " | Generation: "      << snapshot.generation
+              << " | Alive cells: "     << snapshot.aliveCells
+              << " | Block: "           << density.blockSize << "x" << density.blockSize
+              << " | Frame: "           << frame.getBuildTime().count() / 1000 << " us\n";
+        frame.flush();
+    }
+
+    // advances up to the given number of generations on the calling thread,
+    // stopping early when a loop or extinction is detected
+    void step(const int generations) {
+        for (int g = 0; g < generations && loopLength == 0 && !stopRequested; g++) {
+            computeNextGeneration();
+            detectLoop();
+        }
+    }
+
+    // writes the grid and statistics as text, returns false on I/O error
+    bool saveCheckpoint(const std::string& path) const {
+        std::ofstream out(path);
+        writeCheckpoint(out, {pattern.name, rows, cols, generation, currentAliveCells, totalBirths, totalDeaths}, grid);
+        out.flush();
+        return out.good();
+    }
+
+    // restores a checkpoint written by saveCheckpoint, resizing the grid to match
+    bool loadCheckpoint(const std::string& path) {
+        std::ifstream in(path);
+        Checkpoint checkpoint;
+        if (!readCheckpoint(in, checkpoint)) return false;
+
+        const CheckpointInfo& info = checkpoint.info;
+        rows = info.rows;
+        cols = info.cols;
+        reset();
+        grid              = std::move(checkpoint.grid);
+        pattern           = {info.pattern, {}};
+        generation        = info.generation;
+        currentAliveCells = info.aliveCells;
+        totalBirths       = info.totalBirths;
+        totalDeaths       = info.totalDeaths;
+        loaded            = true;
+        return true;
+    }
+
+    void setCheckpointPath(const std::string& path) {
+        checkpointPath = path;
+    }
+
+    // writes the checkpoint after an interrupted run and tells where it went
+    void saveInterrupted() const {
+        std::cout << "Interrupted at generation " << generation;
+        if (saveCheckpoint(checkpointPath)) {
+            std::cout << ", checkpoint written to " << checkpointPath
+                      << " (continue with --resume " << checkpointPath << ")\n";
+        } else {
+            std::cout << ", failed to write checkpoint to " << checkpointPath << "\n";
+        }
+    }
+
+    int getGeneration()  const { return generation; }
+    int getAliveCells()  const { return currentAliveCells; }
+    int getTotalBirths() const { return totalBirths; }
+    int getTotalDeaths() const { return totalDeaths; }
+    int getLoopLength()  const { return loopLength; }
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+    const std::string& getPatternName() const { return pattern.name; }
+
+    // enables determinism mode: the state is hashed every interval generations
+    void setHashInterval(const int interval) {
+        hashInterval = interval;
+    }
+
+    const std::vector<std::pair<int, uint64_t>>& getStateHashes() const {
+        return stateHashes;
+    }
+
+    // checks if all cells are dead or loop is detected; states are compared by their
+    // Zobrist keys, which only the changed rows are rekeyed for
     void detectLoop() {
-        if (areAllDead()) {
+        if (currentAliveCells == 0) {
             loopLength = -1;
             return;
         }
 
-        std::string currentState = serializeGrid();
+        // checks if we've seen the current grid state before, and saves it
+        const auto [entry, inserted] = generationHistory.try_emplace(updateStateKey(), generation);
+        if (!inserted) {
+            loopLength = generation - entry->second;
+            entry->second = generation;
+        }
+    }
+
+    // prints the components of a detected loop with their own periods, rotor and
+    // stator sizes and heat, found by stepping a fresh engine through one more period
+    void printLoopReport() const {
+        if (loopLength <= 0) return;
 
-        // checks if we've seen the current grid state before
-        if (generationHistory.contains(currentState)) {
-            loopLength = generation - generationHistory[currentState];
+        GameOfLife replay(rows, cols);
+        replay.grid              = grid;
+        replay.currentAliveCells = currentAliveCells;
+        std::vector<Snapshot> phases(loopLength);
+        for (auto& phase : phases) {
+            packSnapshot(replay.grid, phase);
+            replay.computeNextGeneration();
         }
 
-        // save the current state
-        generationHistory[currentState] = generation;
+        const auto components = analyzeLoop(phases);
+        std::cout << "Loop report | Period: " << loopLength
+                  << " | Components: "        << components.size() << "\n";
+        for (size_t k = 0; k < components.size(); k++) {
+            const OscillatorComponent& component = components[k];
+            std::cout << "Component " << k + 1
+                      << " | Rows: "   << component.top  << "-" << component.bottom
+                      << " | Cols: "   << component.left << "-" << component.right
+                      << " | Period: " << component.period
+                      << " | Cells: "  << component.minCells;
+            if (component.maxCells != component.minCells) {
+                std::cout << "-" << component.maxCells;
+            }
+            std::cout << " | Rotor: "  << component.rotor
+                      << " | Stator: " << component.stator
+                      << " | Heat: "   << component.heat << "\n";
+        }
+    }
+
+    // clears the grid and places a random soup in its center
+    void placeSoup(const Soup& soup) {
+        reset();
+
+        const int top  = std::max(0, (rows - SOUP_SIDE) / 2);
+        const int left = std::max(0, (cols - SOUP_SIDE) / 2);
+        for (int i = 0; i < std::min(rows, SOUP_SIDE); i++) {
+            for (int j = 0; j < std::min(cols, SOUP_SIDE); j++) {
+                if (soup.get(i, j)) {
+                    grid[top + i][left + j] = ALIVE;
+                    currentAliveCells++;
+                }
+            }
+        }
+    }
+
+    // runs until the grid stabilizes or reaches limit generations, removing escaping
+    // spaceships like runSoup; past states are kept as hashes rather than strings so that
+    // runs far beyond MAX_GENERATIONS fit in memory, and a checkpoint is written every
+    // checkpointInterval generations (0=never) so an interrupted run can be continued;
+    // returns the generation the final state or cycle was first reached, -1 if still evolving
+    int runLifespan(const int limit, const int checkpointInterval) {
+        std::unordered_map<uint64_t, int> seen {{hashState(), generation}};
+        std::vector<std::vector<std::pair<int, int>>> escaped;
+        loopLength = currentAliveCells == 0 ? -1 : 0;
+        while (loopLength == 0 && generation < limit && !stopRequested) {
+            computeNextGeneration();
+            if (generation % ESCAPE_INTERVAL == 0 && removeEscapingShips(escaped) > 0) {
+                seen.clear();   // earlier states still contain the removed ships
+            }
+            if (currentAliveCells == 0) {
+                loopLength = -1;
+                return generation;
+            }
+
+            const auto [entry, inserted] = seen.try_emplace(hashState(), generation);
+            if (!inserted) {
+                loopLength = generation - entry->second;
+                return entry->second;
+            }
+            if (checkpointInterval > 0 && generation % checkpointInterval == 0) {
+                saveCheckpoint(checkpointPath);
+            }
+        }
+        return loopLength == -1 ? generation : -1;
+    }
+
+    enum class SoupResult {
+        Stabilized,                             // the census got its objects and escaped ships
+        Unstable,                               // still evolving at MAX_GENERATIONS, only escaped ships counted
+        OverBudget,                             // still evolving at the budget, nothing counted
+        Interrupted,                            // stopped by a signal, nothing counted
+    };
+
+    // runs a random soup in the center of an empty grid until it stabilizes and adds
+    // the remaining objects and escaped spaceships to the census; a soup still evolving
+    // after budget generations (below MAX_GENERATIONS) is left to be run again in full
+    SoupResult runSoup(const Soup& soup, Census& census, const int budget = MAX_GENERATIONS) {
+        placeSoup(soup);
+        recordStateHash();
+
+        const int limit = std::min(budget, MAX_GENERATIONS);
+        std::vector<std::vector<std::pair<int, int>>> escaped;
+        while (loopLength == 0 && generation < limit && !stopRequested) {
+            computeNextGeneration();
+            if (generation % ESCAPE_INTERVAL == 0) {
+                removeEscapingShips(escaped);
+            }
+            detectLoop();
+        }
+        if (stopRequested) {
+            return SoupResult::Interrupted;
+        }
+        if (loopLength == 0 && limit < MAX_GENERATIONS) {
+            return SoupResult::OverBudget;
+        }
+
+        for (const auto& ship : escaped) {
+            census.add(ship);
+        }
+        if (loopLength == 0) {
+            return SoupResult::Unstable;
+        }
+
+        for (const auto& object : findObjects()) {
+            census.add(object);
+        }
+        return SoupResult::Stabilized;
+    }
+
+    // runs a soup like runSoup but only looks for its loop, taking no census; returns
+    // whether it is still evolving after the given number of generations
+    bool screenSoup(const Soup& soup, const int generations) {
+        placeSoup(soup);
+
+        const int limit = std::min(generations, MAX_GENERATIONS);
+        std::vector<std::vector<std::pair<int, int>>> escaped;
+        while (loopLength == 0 && generation < limit && !stopRequested) {
+            computeNextGeneration();
+            if (generation % ESCAPE_INTERVAL == 0) {
+                removeEscapingShips(escaped);
+            }
+            detectLoop();
+        }
+        return loopLength == 0;
     }
 
     void run() {
-        selectPattern();
-        setPattern();
+        const bool asked = pattern.name.empty() && !loaded;
+        if (asked) {
+            selectPattern();
+        }
+        if (stopRequested) {
+            return;
+        }
+        if (!loaded) {
+            setPattern();
+        }
+        recordStateHash();
         hideCursor();
-        clearScreen();
+        fitView();
         displayGrid();
 
         std::cout << "Press Enter to start simulation...";
         std::cout.flush();
-        std::cin.ignore(1000, '\n');
+        if (asked) {
+            std::cin.ignore(1000, '\n');   // rest of the line with the choice
+        }
         std::cin.get();
         clearScreen();
 
-        // main simulation loop
-        for (int gen = 0; gen < MAX_GENERATIONS; gen++) {
+        // main simulation loop, waiting for keys instead of sleeping between generations
+        RawInput input;
+        cursorRow = rows / 2;
+        cursorCol = cols / 2;
+        for (int gen = 0; gen < MAX_GENERATIONS && !stopRequested; ) {
+            fitView();
             displayGrid();
-            if (loopLength == -1) {
+            if (loopLength == -1 && !paused) {
                 break; // exit if all cells died
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(DELAY_MS));
+
+            const int key = input.readKey(paused ? -1 : DELAY_MS);
+            if (key == 'q' || key == 'Q') {
+                break;
+            }
+            if (key == ' ') {
+                paused = !paused;
+                continue;
+            }
+            if (paused && key != 'n' && key != 'N') {
+                handleEditKey(key);
+                continue;
+            }
+
             computeNextGeneration();
             detectLoop();
+            gen++;
         }
 
         showCursor();
         std::cout << "\nGame ended.\n";
+        printLoopReport();
+        if (stopRequested) {
+            saveInterrupted();
+        }
     }
 };
 
 
 
 
-int main() {
-    srand(time(nullptr));
+// results of stepAll as parallel arrays, one entry per universe
+struct BatchResult {
+    std::vector<int> generation;
+    std::vector<int> aliveCells;
+    std::vector<int> totalBirths;
+    std::vector<int> totalDeaths;
+    std::vector<int> loopLength;                // 0=evolving, -1=extinction, >0=loop period
+};
+
+// advances every universe by up to n generations, stopping each at its loop or extinction;
+// universes are handed to the pool in batches so each wake-up covers many small universes
+BatchResult stepAll(std::vector<GameOfLife>& universes, const int n, ThreadPool& pool) {
+    const size_t count = universes.size();
+    BatchResult result;
+    result.generation.resize(count);
+    result.aliveCells.resize(count);
+    result.totalBirths.resize(count);
+    result.totalDeaths.resize(count);
+    result.loopLength.resize(count);
+
+    const size_t batchSize = std::max<size_t>(1, count / (4 * static_cast<size_t>(pool.size())));
+    pool.parallelFor(count, batchSize, [&](const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            GameOfLife& universe = universes[i];
+            universe.step(n);
+            result.generation[i]  = universe.getGeneration();
+            result.aliveCells[i]  = universe.getAliveCells();
+            result.totalBirths[i] = universe.getTotalBirths();
+            result.totalDeaths[i] = universe.getTotalDeaths();
+            result.loopLength[i]  = universe.getLoopLength();
+        }
+    });
+    return result;
+}
+
+// command line options
+struct Options {
+    long long soups {};                         // number of soups to search (0 = interactive mode)
+    uint64_t  seed  {};                         // seed of the first soup
+    std::string censusPath {"census.csv"};      // where the soup census is written
+    int hashInterval {};                        // generations between state hashes (0=off)
+    std::string hashLogPath;                    // where state hashes are written
+    std::string verifyPath;                     // hash log of a reference run to compare against
+    int patternIndex {-1};                      // predefined pattern (-1=ask)
+    int orientation  {};                        // rotation and mirroring of the pattern (0-7)
+    int boardRows    {};                        // board size (0=terminal size)
+    int boardCols    {};
+    int roi[4]       {};                        // region of interest: top, left, height, width
+    int generations  {};                        // generations to advance without display
+    int threads      {};                        // threads for advancing (0=all cores)
+    int watchMs      {};                        // refresh period of the live view (0=off)
+    int universes    {};                        // independent random universes stepped in a batch
+    std::string checkpointPath {"gameoflife.checkpoint"};  // written when interrupted
+    std::string resumePath;                     // checkpoint to continue from
+    int workers {};                             // soup worker processes to fork
+    std::string ringName;                       // shared memory ring of the soup service
+    std::string workerRing;                     // ring to take soups from as a worker
+    std::string historyPath;                    // "seed,generations" of finished soups, appended
+    int soupBudget {};                          // generations before a soup is set aside as long-lived (0=off)
+    int longWorkers {1};                        // forked workers running only long-lived soups
+    int densityBlock {};                        // side of heatmap blocks (0=show cells)
+    int loopSearch   {};                        // generations to look for a loop to report on
+    int analyticsInterval {};                   // generations between analytics records (0=off)
+    std::string analyticsPath {"analytics.csv"};  // where analytics records are streamed
+    long long methuselahs {};                   // soups screened for long-lived patterns
+    int screenGenerations {1000};               // generations a soup must survive to be promoted
+    int lifespanLimit {100000};                 // generations promoted soups are run for at most
+    std::string serveAddress;                   // where a remote viewer can connect (empty=off)
+};
+
+static constexpr int SOUP_BOARD_SIZE {64};      // side of the torus soups are run on
+static constexpr int ANALYTICS_DISTANCES {8};   // correlation distances in analytics records
+static constexpr int ANALYST_MAX_THREADS {2};   // analytics threads alongside a stepping run
+static constexpr uint32_t SOUP_RING_CAPACITY {1024};    // soups buffered between producer and workers
+static constexpr auto SOUP_RING_WAIT = std::chrono::microseconds(200);  // sleep when full or empty
+static constexpr int SOUP_RING_ATTACH_ATTEMPTS {100};   // 100 ms apart, for workers started first
+static constexpr long long SOUP_SCHEDULE_WINDOW {256};  // soups ordered by predicted time at once
+static constexpr char LONG_RING_SUFFIX[] {"-long"};     // ring of soups over the budget
+static constexpr int METHUSELAH_BOARD_SIZE {256};       // torus promoted soups are run on
+static constexpr int METHUSELAH_CHECKPOINT_INTERVAL {10000};    // generations between checkpoints
+static constexpr int VIEWER_ACCEPT_MS {100};    // wait for a viewer between stop checks
+
+bool parseOptions(const int argc, char* argv[], Options& options) {
+    options.seed = static_cast<uint64_t>(time(nullptr));
+
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            return false;   // every option takes a value
+        }
+        const std::string value = argv[++i];
+        try {
+            if (arg == "--soup") {
+                options.soups = std::stoll(value);
+            } else if (arg == "--seed") {
+                options.seed = std::stoull(value);
+            } else if (arg == "--census") {
+                options.censusPath = value;
+            } else if (arg == "--check-every") {
+                options.hashInterval = std::stoi(value);
+            } else if (arg == "--hash-log") {
+                options.hashLogPath = value;
+            } else if (arg == "--verify") {
+                options.verifyPath = value;
+            } else if (arg == "--pattern") {
+                options.patternIndex = std::stoi(value);
+            } else if (arg == "--size") {
+                if (std::sscanf(value.c_str(), "%dx%d", &options.boardRows, &options.boardCols) != 2 ||
+                    options.boardRows <= 0 || options.boardCols <= 0) {
+                    return false;
+                }
+            } else if (arg == "--roi") {
+                auto& roi = options.roi;
+                if (std::sscanf(value.c_str(), "%d,%d,%d,%d", &roi[0], &roi[1], &roi[2], &roi[3]) != 4) {
+                    return false;
+                }
+            } else if (arg == "--generations") {
+                options.generations = std::stoi(value);
+            } else if (arg == "--threads") {
+                options.threads = std::stoi(value);
+            } else if (arg == "--watch") {
+                options.watchMs = std::stoi(value);
+            } else if (arg == "--universes") {
+                options.universes = std::stoi(value);
+            } else if (arg == "--analytics-every") {
+                options.analyticsInterval = std::stoi(value);
+            } else if (arg == "--analytics-log") {
+                options.analyticsPath = value;
+            } else if (arg == "--orientation") {
+                options.orientation = std::stoi(value);
+            } else if (arg == "--find-loop") {
+                options.loopSearch = std::stoi(value);
+            } else if (arg == "--density") {
+                options.densityBlock = std::stoi(value);
+            } else if (arg == "--checkpoint") {
+                options.checkpointPath = value;
+            } else if (arg == "--resume") {
+                options.resumePath = value;
+            } else if (arg == "--workers") {
+                options.workers = std::stoi(value);
+            } else if (arg == "--soup-ring") {
+                options.ringName = value;
+            } else if (arg == "--soup-worker") {
+                options.workerRing = value;
+            } else if (arg == "--soup-history") {
+                options.historyPath = value;
+            } else if (arg == "--soup-budget") {
+                options.soupBudget = std::stoi(value);
+            } else if (arg == "--long-workers") {
+                options.longWorkers = std::stoi(value);
+            } else if (arg == "--methuselahs") {
+                options.methuselahs = std::stoll(value);
+            } else if (arg == "--screen") {
+                options.screenGenerations = std::stoi(value);
+            } else if (arg == "--lifespan-limit") {
+                options.lifespanLimit = std::stoi(value);
+            } else if (arg == "--serve") {
+                options.serveAddress = value;
+            } else {
+                return false;
+            }
+        } catch (const std::exception&) {
+            return false;
+        }
+    }
+    if (options.patternIndex >= static_cast<int>(PATTERNS.size()) ||
+        options.orientation < 0 || options.orientation > 7 ||
+        options.boardRows < 0 || options.boardCols < 0 ||
+        options.roi[2] < 0 || options.roi[3] < 0 || options.generations < 0 || options.threads < 0 ||
+        options.watchMs < 0 || options.universes < 0 || options.workers < 0 ||
+        options.densityBlock < 0 || options.loopSearch < 0 ||
+        options.analyticsInterval < 0 || options.methuselahs < 0 ||
+        options.screenGenerations <= 0 || options.lifespanLimit <= options.screenGenerations) {
+        return false;
+    }
+    // soups run in other processes are not hashed
+    const bool service = options.workers > 0 || !options.ringName.empty() || !options.workerRing.empty();
+    if (service && options.hashInterval > 0) {
+        return false;
+    }
+    // set aside soups are hashed out of seed order, and forked workers need a queue for them
+    if (options.soupBudget < 0 || options.longWorkers < 0 || (options.soupBudget > 0 && options.hashInterval > 0) ||
+        (options.soupBudget > 0 && options.workers > 0 && options.longWorkers == 0)) {
+        return false;
+    }
+    // only a plain --generations run streams, and it publishes every generation for that
+    if (!options.serveAddress.empty() &&
+        (options.generations == 0 || options.universes > 0 || options.soups > 0 || options.methuselahs > 0 ||
+         !options.workerRing.empty() || options.loopSearch > 0 || (options.roi[2] > 0 && options.roi[3] > 0))) {
+        return false;
+    }
+    // verification and hash logs need state hashes
+    return options.hashInterval >= 0 &&
+           (options.hashInterval > 0 || (options.verifyPath.empty() && options.hashLogPath.empty()));
+}
+
+// opens the soup history for appending; records are flushed one line at a time, so
+// several processes can append to the same file
+bool openHistory(const std::string& path, std::ofstream& history) {
+    if (path.empty()) {
+        return true;
+    }
+    history.open(path, std::ios::app);
+    if (!history) {
+        std::cerr << "Failed to open soup history " << path << "\n";
+        return false;
+    }
+    return true;
+}
+
+void recordHistory(std::ofstream& history, const uint64_t seed, const int generations) {
+    if (history.is_open()) {
+        history << seed << ',' << generations << std::endl;
+    }
+}
+
+// searches random soups and writes the census of the objects they leave behind;
+// soup i uses seed + i, so runs on different machines should use disjoint seed ranges
+int runSoupSearch(const Options& options) {
+    GameOfLife game(SOUP_BOARD_SIZE, SOUP_BOARD_SIZE);
+    game.setHashInterval(options.hashInterval);
+    Census census;
+    long long unstable = 0;
+
+    // determinism mode: hashes are logged, compared against a reference run and
+    // folded into a digest embedded in the census header
+    HashLog reference;
+    if (!options.verifyPath.empty()) {
+        std::ifstream referenceLog(options.verifyPath);
+        if (!readHashLog(referenceLog, reference)) {
+            std::cerr << "Failed to read hash log " << options.verifyPath << "\n";
+            return 1;
+        }
+    }
+    std::ofstream hashLog;
+    if (!options.hashLogPath.empty()) {
+        hashLog.open(options.hashLogPath);
+        if (!hashLog) {
+            std::cerr << "Failed to write hash log " << options.hashLogPath << "\n";
+            return 1;
+        }
+        hashLog << "# seed,generation,hash every " << options.hashInterval << " generations\n";
+    }
+    uint64_t digest = hashCode("");
+    std::ofstream history;
+    if (!openHistory(options.historyPath, history)) {
+        return 1;
+    }
+
+    // with a budget, soups still evolving after it are set aside and run in full once all
+    // others are done, so the many short soups are not held up behind a few methuselahs
+    const int budget = options.soupBudget > 0 ? options.soupBudget : INT_MAX;
+    std::vector<uint64_t> longLived;
+    long long searched = 0;
+    long long attempted = 0;                    // seeds of the first pass finished or set aside
+    for (size_t next = 0; !stopRequested; ) {
+        const bool firstPass = attempted < options.soups;
+        if (!firstPass && next == longLived.size()) {
+            break;
+        }
+        const uint64_t seed = firstPass ? options.seed + attempted : longLived[next];
+        const auto result = game.runSoup(generateSoup(seed), census, firstPass ? budget : INT_MAX);
+        if (result == GameOfLife::SoupResult::Interrupted) {
+            break;  // the interrupted soup added nothing to the census
+        }
+        if (firstPass) {
+            attempted++;
+        } else {
+            next++;
+        }
+        if (result == GameOfLife::SoupResult::OverBudget) {
+            longLived.push_back(seed);
+            continue;
+        }
+
+        searched++;
+        if (result == GameOfLife::SoupResult::Unstable) {
+            unstable++;
+        }
+        recordHistory(history, seed, game.getGeneration());
+
+        for (const auto& [generation, hash] : game.getStateHashes()) {
+            digest = hashCode(formatHash(digest) + formatHash(hash));
+            if (hashLog.is_open()) {
+                hashLog << seed << ',' << generation << ',' << formatHash(hash) << '\n';
+            }
+
+            const auto expected = reference.find({seed, generation});
+            if (expected != reference.end() && expected->second != hash) {
+                std::cerr << "Divergence in soup " << seed << " at generation " << generation
+                          << ": expected " << formatHash(expected->second)
+                          << ", got " << formatHash(hash) << "\n";
+                return 2;
+            }
+        }
+    }
+
+    hashLog.close();    // flush before reporting, also after an interrupt
+
+    if (options.hashInterval > 0) {
+        census.addNote("state digest " + formatHash(digest) + " (hash every " +
+                       std::to_string(options.hashInterval) + " generations, seeds " +
+                       std::to_string(options.seed) + "-" +
+                       std::to_string(options.seed + searched - 1) + ")");
+    }
+
+    if (!census.write(options.censusPath)) {
+        std::cerr << "Failed to write census to " << options.censusPath << "\n";
+        return 1;
+    }
+    if (stopRequested) {
+        std::cout << "Interrupted, census covers the completed soups\n";
+    }
+    std::cout << "Soups: "               << searched
+              << " | Seeds: "            << options.seed << "-" << options.seed + attempted - 1
+              << " | Distinct objects: " << census.size()
+              << " | Not stabilized: "   << unstable;
+    if (options.soupBudget > 0) {
+        std::cout << " | Long-lived: " << longLived.size();
+    }
+    if (options.hashInterval > 0) {
+        std::cout << " | State digest: " << formatHash(digest);
+    }
+    std::cout << "\n";
+    return 0;
+}
+
+// attaches to a ring, giving its producer some time to create it
+std::unique_ptr<SoupRing> attachSoupRing(const std::string& ringName) {
+    std::unique_ptr<SoupRing> ring;
+    for (int attempt = 0; !ring && attempt < SOUP_RING_ATTACH_ATTEMPTS && !stopRequested; attempt++) {
+        ring = SoupRing::attach(ringName);
+        if (!ring) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+    }
+    if (!ring) {
+        std::cerr << "Failed to attach to soup ring " << ringName << "\n";
+    }
+    return ring;
+}
+
+// takes soups from a shared ring until the producer is done and writes their census; with a
+// budget, soups still evolving after it are handed to the long-lived ring <ring>-long
+int runSoupWorker(const std::string& ringName, const std::string& censusPath, const std::string& historyPath,
+                  const int budget) {
+    const auto ring = attachSoupRing(ringName);
+    const auto longRing = budget > 0 ? attachSoupRing(ringName + LONG_RING_SUFFIX) : nullptr;
+    if (!ring || (budget > 0 && !longRing)) {
+        return 1;
+    }
+
+    std::ofstream history;
+    if (!openHistory(historyPath, history)) {
+        return 1;
+    }
+
+    GameOfLife game(SOUP_BOARD_SIZE, SOUP_BOARD_SIZE);
+    Census census;
+    Soup soup;
+    while (!stopRequested) {
+        const auto result = ring->tryPop(soup);
+        if (result == SoupRing::PopResult::Closed) {
+            break;
+        }
+        if (result == SoupRing::PopResult::Empty) {
+            std::this_thread::sleep_for(SOUP_RING_WAIT);
+            continue;
+        }
+
+        const auto soupResult = game.runSoup(soup, census, budget > 0 ? budget : INT_MAX);
+        if (soupResult == GameOfLife::SoupResult::Interrupted) {
+            break;  // the interrupted soup added nothing to the census
+        }
+        if (soupResult == GameOfLife::SoupResult::OverBudget) {
+            while (!longRing->tryPush(soup) && !stopRequested) {
+                std::this_thread::sleep_for(SOUP_RING_WAIT);
+            }
+            if (stopRequested) {
+                break;
+            }
+            ring->reportDeferred();
+            continue;
+        }
+        ring->reportResult(soupResult == GameOfLife::SoupResult::Stabilized);
+        recordHistory(history, soup.seed, game.getGeneration());
+    }
+
+    if (!census.write(censusPath)) {
+        std::cerr << "Failed to write census to " << censusPath << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+// generates seeded soups into a shared memory ring for worker processes; with --workers
+// they are forked here and their partial censuses merged, otherwise workers are started
+// separately with --soup-worker <ring> and their census files merged with census_merge
+int runSoupService(const Options& options) {
+    const std::string name = !options.ringName.empty() ? options.ringName
+                                                        : "/gameoflife-soups-" + std::to_string(getpid());
+    // soups finished by earlier runs teach the model before the workers start
+    StabilizationModel model;
+    if (!options.historyPath.empty() && !model.learnHistory(options.historyPath)) {
+        std::cerr << "Failed to read soup history " << options.historyPath << "\n";
+        return 1;
+    }
+
+    // with a budget, soups over it go to a second ring served by their own workers, so the
+    // general workers keep clearing the many short soups
+    const bool budgeted = options.soupBudget > 0;
+    const std::string longName = name + LONG_RING_SUFFIX;
+    const auto ring = SoupRing::create(name, SOUP_RING_CAPACITY);
+    const auto longRing = budgeted ? SoupRing::create(longName, SOUP_RING_CAPACITY) : nullptr;
+    if (!ring || (budgeted && !longRing)) {
+        std::cerr << "Failed to create soup ring " << (ring ? longName : name) << "\n";
+        return 1;
+    }
+
+    std::vector<pid_t> children;
+    std::vector<pid_t> longChildren;
+    std::vector<std::string> parts;
+    std::cout.flush();
+    const int longWorkers = budgeted && options.workers > 0 ? options.longWorkers : 0;
+    bool forked = true;
+    for (int k = 0; k < options.workers + longWorkers && forked; k++) {
+        const bool longLived = k >= options.workers;
+        const std::string part = options.censusPath + ".worker" + std::to_string(k);
+        const pid_t pid = fork();
+        if (pid == 0) {
+            _exit(longLived ? runSoupWorker(longName, part, options.historyPath, 0)
+                            : runSoupWorker(name, part, options.historyPath, options.soupBudget));
+        }
+        forked = pid > 0;
+        if (forked) {
+            (longLived ? longChildren : children).push_back(pid);
+            parts.push_back(part);
+        }
+    }
+
+    // separate workers report through the rings; forked ones are simply waited for
+    bool workersOk = true;
+    const auto waitWorkers = [&](const std::vector<pid_t>& pids) {
+        for (const pid_t child : pids) {
+            int status = 0;
+            while (waitpid(child, &status, 0) == -1 && errno == EINTR) {}
+            workersOk = workersOk && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+        }
+    };
+    if (!forked) {
+        // the workers already started find the rings closed and empty and exit
+        ring->close();
+        if (budgeted) {
+            longRing->close();
+        }
+        waitWorkers(children);
+        waitWorkers(longChildren);
+        for (const auto& part : parts) {
+            std::remove(part.c_str());
+        }
+        std::cerr << "Failed to start soup workers\n";
+        return 1;
+    }
+    if (options.workers == 0) {
+        std::cout << "Soup ring " << name << " ready, start workers with --soup-worker " << name;
+        if (budgeted) {
+            std::cout << " --soup-budget " << options.soupBudget << " and long-lived soup workers with --soup-worker "
+                      << longName;
+        }
+        std::cout << "\n";
+        std::cout.flush();
+    }
+
+    // with a trained model each window of soups goes out longest predicted first, so the
+    // slow soups start early instead of keeping one worker busy after the others finished
+    long long produced = 0;
+    std::vector<std::pair<double, Soup>> window;    // pushed from the back
+    while ((produced < options.soups || !window.empty()) && !stopRequested) {
+        if (window.empty()) {
+            const long long count = std::min(SOUP_SCHEDULE_WINDOW, options.soups - produced);
+            for (long long k = count - 1; k >= 0; k--) {
+                const Soup soup = generateSoup(options.seed + produced + k);
+                window.emplace_back(model.getSamples() > 0 ? model.predict(soupFeatures(soup)) : 0.0, soup);
+            }
+            std::ranges::stable_sort(window, {}, [](const auto& entry) { return entry.first; });
+            produced += count;
+        }
+
+        if (ring->tryPush(window.back().second)) {
+            window.pop_back();
+        } else {
+            std::this_thread::sleep_for(SOUP_RING_WAIT);
+        }
+    }
+    ring->close();
+
+    while (children.empty() && ring->completed() + ring->deferred() < static_cast<uint64_t>(produced) &&
+           !stopRequested) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    waitWorkers(children);
+
+    // every soup over the budget has been handed on once the general workers are done
+    if (budgeted) {
+        longRing->close();
+        while (longChildren.empty() && longRing->completed() < ring->deferred() && !stopRequested) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        waitWorkers(longChildren);
+    }
+    const uint64_t longCompleted = budgeted ? longRing->completed() : 0;
+
+    if (!parts.empty()) {
+        const bool merged = workersOk && mergeCensusFiles(parts, options.censusPath);
+        for (const auto& part : parts) {
+            std::remove(part.c_str());
+        }
+        if (!merged) {
+            std::cerr << "Failed to collect the census of the soup workers\n";
+            return 1;
+        }
+    }
+
+    if (stopRequested) {
+        std::cout << "Interrupted, census covers the completed soups\n";
+    }
+    std::cout << "Soups: "             << ring->completed() + longCompleted
+              << " | Seeds: "          << options.seed << "-" << options.seed + produced - 1
+              << " | Workers: "        << children.size() + longChildren.size()
+              << " | Not stabilized: " << ring->unstable() + (budgeted ? longRing->unstable() : 0);
+    if (budgeted) {
+        std::cout << " | Long-lived: " << ring->deferred();
+    }
+    std::cout << " | Order: "          << (model.getSamples() > 0 ? "longest predicted first (" +
+                                           std::to_string(model.getSamples()) + " past soups)" : "by seed")
+              << "\n";
+    return 0;
+}
+
+// result of a soup promoted by the methuselah search
+struct Methuselah {
+    uint64_t seed    {};
+    int initialCells {};
+    bool ran         {};                        // false if the search stopped before its run
+    int lifespan     {-1};                      // generation it stabilized or died (-1=still evolving)
+    int generation   {};                        // generation reached
+    int population   {};                        // alive cells at that generation
+    int period       {};                        // of the final state (-1=extinction, 0=evolving)
+};
+
+// screens soups for a few generations in parallel and runs the survivors on a larger
+// board far beyond MAX_GENERATIONS, checkpointing each so that an interrupted search run
+// again with the same options continues where it stopped; prints them ranked by lifespan
+int runMethuselahSearch(const Options& options) {
+    ThreadPool pool(options.threads);
+
+    // soups still evolving after the screen are promoted, most die out or settle by then
+    std::vector<char> promoted(options.methuselahs, 0);
+    const size_t screenBatch = std::max<size_t>(1, promoted.size() / (4 * static_cast<size_t>(pool.size())));
+    pool.parallelFor(promoted.size(), screenBatch, [&](const size_t begin, const size_t end) {
+        GameOfLife game(SOUP_BOARD_SIZE, SOUP_BOARD_SIZE);
+        for (size_t k = begin; k < end && !stopRequested; k++) {
+            promoted[k] = game.screenSoup(generateSoup(options.seed + k), options.screenGenerations);
+        }
+    });
+    if (stopRequested) {
+        std::cout << "Interrupted while screening\n";
+        return 0;
+    }
+
+    std::vector<Methuselah> results;
+    for (size_t k = 0; k < promoted.size(); k++) {
+        if (promoted[k]) {
+            Methuselah& result = results.emplace_back(options.seed + k);
+            const Soup soup = generateSoup(result.seed);
+            for (int i = 0; i < SOUP_SIDE; i++) {
+                for (int j = 0; j < SOUP_SIDE; j++) {
+                    result.initialCells += soup.get(i, j);
+                }
+            }
+        }
+    }
+
+    // one soup per batch, long runs vary too much in length to be grouped
+    pool.parallelFor(results.size(), 1, [&](const size_t begin, const size_t end) {
+        for (size_t k = begin; k < end && !stopRequested; k++) {
+            Methuselah& result = results[k];
+            result.ran = true;
+            const Soup soup = generateSoup(result.seed);
+
+            const std::string checkpoint = options.checkpointPath + "." + std::to_string(result.seed);
+            GameOfLife game(METHUSELAH_BOARD_SIZE, METHUSELAH_BOARD_SIZE);
+            if (!game.loadCheckpoint(checkpoint)) {
+                game.placeSoup(soup);
+            }
+            game.setCheckpointPath(checkpoint);
+            result.lifespan   = game.runLifespan(options.lifespanLimit, METHUSELAH_CHECKPOINT_INTERVAL);
+            result.generation = game.getGeneration();
+            result.population = game.getAliveCells();
+            result.period     = game.getLoopLength();
+            if (stopRequested && result.lifespan == -1) {
+                game.saveCheckpoint(checkpoint);
+            } else {
+                std::remove(checkpoint.c_str());
+            }
+        }
+    });
+
+    // soups still evolving at the limit rank first, among them the furthest ahead; soups
+    // the search never got to rank last
+    std::ranges::sort(results, std::greater<>(), [](const Methuselah& result) {
+        return std::tuple(result.ran, result.lifespan == -1,
+                          result.lifespan == -1 ? result.generation : result.lifespan);
+    });
+    std::cout << "Soups: "     << options.methuselahs
+              << " | Seeds: "  << options.seed << "-" << options.seed + options.methuselahs - 1
+              << " | Promoted after " << options.screenGenerations << " generations: " << results.size() << "\n";
+    for (size_t k = 0; k < results.size(); k++) {
+        const Methuselah& result = results[k];
+        std::cout << "Rank " << k + 1
+                  << " | Seed: "       << result.seed
+                  << " | Cells: "      << result.initialCells
+                  << " | Lifespan: ";
+        if (!result.ran) {
+            std::cout << "not run\n";
+            continue;
+        }
+        if (result.lifespan >= 0) {
+            std::cout << result.lifespan;
+        } else {
+            std::cout << (stopRequested ? "interrupted at " : "over ") << result.generation;
+        }
+        std::cout << " | Population: " << result.population
+                  << " | Final: "      << (result.period == -1 ? "extinct"
+                                          : result.period > 0 ? "period " + std::to_string(result.period)
+                                          : "evolving")
+                  << "\n";
+    }
+    if (stopRequested) {
+        std::cout << "Interrupted, run again with the same options to continue from the checkpoints\n";
+    }
+    return 0;
+}
+
+// advances a region of interest of a predefined pattern and prints it
+int runRegionOfInterest(const Options& options) {
+    GameOfLife game = options.boardRows > 0 ? GameOfLife(options.boardRows, options.boardCols)
+                                            : GameOfLife();
+    game.setHashInterval(options.hashInterval);
+    game.selectPattern(std::max(options.patternIndex, 0));
+    game.setOrientation(options.orientation);
+    game.setPattern();
+
+    // the region may start anywhere, its corner is brought onto the torus once
+    const auto [roiTop, roiLeft, height, width] = options.roi;
+    const int top  = (roiTop % game.getRows() + game.getRows()) % game.getRows();
+    const int left = (roiLeft % game.getCols() + game.getCols()) % game.getCols();
+    game.advanceRegion(top, left, height, width, options.generations);
+    game.printRegion(top, left, height, width);
+    return 0;
+}
+
+// steps a predefined pattern until it loops and reports the oscillating components
+int runLoopSearch(const Options& options) {
+    GameOfLife game = options.boardRows > 0 ? GameOfLife(options.boardRows, options.boardCols)
+                                            : GameOfLife();
+    game.setHashInterval(options.hashInterval);
+    if (!options.resumePath.empty()) {
+        if (!game.loadCheckpoint(options.resumePath)) {
+            std::cerr << "Failed to read checkpoint " << options.resumePath << "\n";
+            return 1;
+        }
+    } else {
+        game.selectPattern(std::max(options.patternIndex, 0));
+        game.setOrientation(options.orientation);
+        game.setPattern();
+    }
+    game.detectLoop();  // the starting state is part of the history
+
+    game.step(options.loopSearch);
+    game.printStatus();
+    std::cout << "\n";
+    if (game.getLoopLength() > 0) {
+        game.printLoopReport();
+    } else if (game.getLoopLength() == 0) {
+        std::cout << "No loop within " << options.loopSearch << " generations\n";
+    }
+    return 0;
+}
+
+// advances a predefined pattern without display and prints statistics and timing
+int runAdvance(const Options& options) {
+    GameOfLife game = options.boardRows > 0 ? GameOfLife(options.boardRows, options.boardCols)
+                                            : GameOfLife();
+    game.setHashInterval(options.hashInterval);
+    game.setCheckpointPath(options.checkpointPath);
+    if (!options.resumePath.empty()) {
+        if (!game.loadCheckpoint(options.resumePath)) {
+            std::cerr << "Failed to read checkpoint " << options.resumePath << "\n";
+            return 1;
+        }
+    } else {
+        game.selectPattern(std::max(options.patternIndex, 0));
+        game.setOrientation(options.orientation);
+        game.setPattern();
+    }
+
+    // the live view and the analytics stream read published snapshots at their own rate,
+    // never slowing the engine
+    SnapshotPublisher publisher(game.getRows(), game.getCols());
+    const bool everyGeneration = options.watchMs > 0 || !options.serveAddress.empty();
+    if (everyGeneration || options.analyticsInterval > 0) {
+        game.setPublisher(&publisher, everyGeneration ? 1 : options.analyticsInterval);
+    }
+
+    // a remote viewer gets the newest generation each time the previous one has been
+    // sent, so a slow link drops generations instead of falling behind
+    std::unique_ptr<StreamServer> server;
+    std::jthread streamer;
+    if (!options.serveAddress.empty()) {
+        server = StreamServer::listen(options.serveAddress, game.getRows(), game.getCols());
+        if (!server) {
+            std::cerr << "Failed to listen on " << options.serveAddress << "\n";
+            return 1;
+        }
+        streamer = std::jthread([&publisher, &server](std::stop_token stop) {
+            Snapshot snapshot;
+            while (!stop.stop_requested()) {
+                if (!server->waitForViewer(VIEWER_ACCEPT_MS)) continue;
+                snapshot.version = 0;   // a new viewer starts with the current generation
+                while (!stop.stop_requested()) {
+                    if (publisher.version() != snapshot.version && publisher.read(snapshot)) {
+                        if (!server->send(snapshot)) break;
+                    } else {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    }
+                }
+            }
+            // the final generation, unless the viewer already has it
+            if (publisher.version() != snapshot.version && publisher.read(snapshot)) {
+                server->send(snapshot);
+            }
+        });
+    }
+
+    const int threads = options.threads > 0 ? options.threads
+                                            : std::max(1u, std::thread::hardware_concurrency());
+
+    // a record is written for every multiple of the interval the analyst sees; if it falls
+    // behind the engine it skips generations rather than holding the engine back. The
+    // analyst only gets the cores the bands leave free, at least one and at most
+    // ANALYST_MAX_THREADS: it may skip records, the bands must not be slowed down
+    std::ofstream analyticsLog;
+    std::jthread analyst;
+    if (options.analyticsInterval > 0) {
+        analyticsLog.open(options.analyticsPath);
+        if (!analyticsLog) {
+            std::cerr << "Failed to write analytics to " << options.analyticsPath << "\n";
+            return 1;
+        }
+        analyticsLog << "# GameOfLife analytics v1\n" << "generation,alive,density,entropy";
+        for (int d = 1; d <= ANALYTICS_DISTANCES; d++) {
+            analyticsLog << ",correlation" << d;
+        }
+        analyticsLog << "\n";
+
+        const int cores = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        const int analystThreads = std::clamp(cores - threads, 1, ANALYST_MAX_THREADS);
+        analyst = std::jthread([&publisher, &options, &analyticsLog, analystThreads](std::stop_token stop) {
+            ThreadPool pool(analystThreads);
+            Snapshot snapshot;
+            int recorded = -1;
+            const auto record = [&] {
+                if (snapshot.generation % options.analyticsInterval != 0 || snapshot.generation == recorded) return;
+                const Analytics analytics = analyzeSnapshot(snapshot, ANALYTICS_DISTANCES, pool);
+                analyticsLog << analytics.generation << "," << analytics.aliveCells << ","
+                             << analytics.density << "," << analytics.entropy;
+                for (const double correlation : analytics.correlation) {
+                    analyticsLog << "," << correlation;
+                }
+                analyticsLog << std::endl;  // streamed, readable while the run goes on
+                recorded = snapshot.generation;
+            };
+
+            while (!stop.stop_requested()) {
+                if (publisher.version() != snapshot.version && publisher.read(snapshot)) {
+                    record();
+                } else {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+            }
+            if (publisher.read(snapshot)) {
+                record();
+            }
+        });
+    }
+
+    std::jthread renderer;
+    if (options.watchMs > 0) {
+        GameOfLife::hideCursor();
+        GameOfLife::clearScreen();
+        renderer = std::jthread([&publisher, &options, name = game.getPatternName()](std::stop_token stop) {
+            // the heatmap is counted on its own threads, the engine's are busy stepping
+            ThreadPool pool(options.densityBlock > 0 ? options.threads : 1);
+            int fitted = -1;                    // terminalResizes the view was fitted to
+            std::pair<int, int> view;
+            FrameBuffer frame;
+            const auto show = [&](const Snapshot& snapshot) {
+                if (const int resizes = terminalResizes.load(std::memory_order_relaxed); resizes != fitted) {
+                    fitted = resizes;
+                    const int block = std::max(options.densityBlock, 1);
+                    view = GameOfLife::viewSize((snapshot.rows + block - 1) / block, (snapshot.cols + block - 1) / block);
+                    frame.reserve(GameOfLife::frameBytes(view.first, view.second));
+                    GameOfLife::clearScreen();
+                }
+                if (options.densityBlock > 0) {
+                    GameOfLife::displayDensity(frame, snapshot, computeDensity(snapshot, options.densityBlock, pool),
+                                               name, view.first, view.second);
+                } else {
+                    GameOfLife::displaySnapshot(frame, snapshot, name, view.first, view.second);
+                }
+            };
+
+            Snapshot snapshot;
+            while (!stop.stop_requested()) {
+                if (publisher.version() != snapshot.version && publisher.read(snapshot)) {
+                    show(snapshot);
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(options.watchMs));
+            }
+            if (publisher.read(snapshot)) {
+                show(snapshot);
+            }
+        });
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    game.advance(options.generations, threads);
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+    if (analyst.joinable()) {
+        analyst.request_stop();
+        analyst.join();
+    }
+    if (streamer.joinable()) {
+        streamer.request_stop();
+        streamer.join();
+    }
+    if (renderer.joinable()) {
+        renderer.request_stop();
+        renderer.join();
+        GameOfLife::showCursor();
+    } else if (options.densityBlock > 0) {
+        // no live view, show the heatmap of the final generation
+        game.setPublisher(&publisher, 1);
+        Snapshot snapshot;
+        ThreadPool pool(options.threads);
+        if (publisher.read(snapshot)) {
+            const DensityMap density = computeDensity(snapshot, options.densityBlock, pool);
+            const auto [viewRows, viewCols] = GameOfLife::viewSize(density.rows, density.cols);
+            FrameBuffer frame;
+            GameOfLife::clearScreen();
+            GameOfLife::displayDensity(frame, snapshot, density, game.getPatternName(), viewRows, viewCols);
+        }
+    }
+    game.printStatus();
+    std::cout << " | Threads: " << threads << " | Time: " << elapsed.count() << " ms\n";
+    game.printThreadStats();
+    if (stopRequested) {
+        game.saveInterrupted();
+    }
+    return 0;
+}
+
+// steps many small random universes with one batch call and summarizes their states
+int runBatch(const Options& options) {
+    const int rows = options.boardRows > 0 ? options.boardRows : SOUP_BOARD_SIZE;
+    const int cols = options.boardCols > 0 ? options.boardCols : SOUP_BOARD_SIZE;
+    std::vector<GameOfLife> universes(options.universes, GameOfLife(rows, cols));
+    for (int i = 0; i < options.universes; i++) {
+        universes[i].randomize(options.seed + i);
+    }
+
+    // with --watch every universe publishes its generations and a dashboard tiles them,
+    // each refresh built in memory and written at once so it stays smooth over slow links
+    std::vector<std::unique_ptr<SnapshotPublisher>> publishers;
+    std::jthread renderer;
+    if (options.watchMs > 0) {
+        for (GameOfLife& universe : universes) {
+            publishers.push_back(std::make_unique<SnapshotPublisher>(rows, cols));
+            universe.setPublisher(publishers.back().get(), 1);
+        }
+        GameOfLife::hideCursor();
+        GameOfLife::clearScreen();
+        std::cout.flush();
+        renderer = std::jthread([&publishers, &options, rows, cols](std::stop_token stop) {
+            int fitted = -1;                    // terminalResizes the layout was made for
+            DashboardLayout layout;
+            FrameBuffer frame;
+            std::vector<Snapshot> snapshots;
+            const auto show = [&] {
+                // a resize only changes the layout and how many snapshots are kept
+                if (const int resizes = terminalResizes.load(std::memory_order_relaxed); resizes != fitted) {
+                    fitted = resizes;
+                    const auto [terminalRows, terminalCols] = terminalSize();
+                    layout = layoutDashboard(options.universes, rows, cols, terminalRows, terminalCols);
+                    snapshots.resize(layout.shown);
+                    frame.reserve(static_cast<size_t>(terminalRows) * (terminalCols + DASHBOARD_LINE_ESCAPES));
+                    writeFrame("\033[2J");
+                }
+                for (size_t k = 0; k < snapshots.size(); k++) {
+                    if (publishers[k]->version() != snapshots[k].version) {
+                        publishers[k]->read(snapshots[k]);
+                    }
+                }
+                frame.begin();
+                renderDashboard(frame, snapshots, layout, options.universes);
+                frame.flush();
+            };
+
+            while (!stop.stop_requested()) {
+                show();
+                std::this_thread::sleep_for(std::chrono::milliseconds(options.watchMs));
+            }
+            show();
+        });
+    }
+
+    ThreadPool pool(options.threads);
+    const auto start = std::chrono::steady_clock::now();
+    const BatchResult result = stepAll(universes, options.generations, pool);
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    if (renderer.joinable()) {
+        renderer.request_stop();
+        renderer.join();
+        GameOfLife::showCursor();
+        std::cout << "\n";
+    }
+
+    int looped = 0;
+    int extinct = 0;
+    for (const int loop : result.loopLength) {
+        looped  += loop > 0;
+        extinct += loop == -1;
+    }
+    std::cout << "Universes: "   << options.universes
+              << " | Size: "     << rows << "x" << cols
+              << " | Loops: "    << looped
+              << " | Extinct: "  << extinct
+              << " | Evolving: " << options.universes - looped - extinct
+              << " | Threads: "  << pool.size()
+              << " | Time: "     << elapsed.count() << " ms\n";
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    // no SA_RESTART, so blocking reads return and the loops notice the request
+    struct sigaction action {};
+    action.sa_handler = requestStop;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+
+    // a resize only marks the views for refitting, interrupted reads carry on
+    struct sigaction resize {};
+    resize.sa_handler = noteResize;
+    resize.sa_flags   = SA_RESTART;
+    sigemptyset(&resize.sa_mask);
+    sigaction(SIGWINCH, &resize, nullptr);
+
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "Usage: " << argv[0] << " [--soup <count>] [--seed <seed>] [--census <file>]\n"
+                  << "  [--workers <processes>] [--soup-ring <name>] [--soup-worker <name>] [--soup-history <file>]\n"
+                  << "  [--soup-budget <generations> [--long-workers <processes>]]\n"
+                  << "  [--methuselahs <count> [--screen <generations>] [--lifespan-limit <generations>]]\n"
+                  << "  [--check-every <generations> [--hash-log <file>] [--verify <hash log>]]\n"
+                  << "  [--pattern <index> [--orientation <0-7>]] [--size <rows>x<cols>]\n"
+                  << "  [--generations <count> [--threads <count>] [--watch <refresh ms>] [--universes <count>]\n"
+                  << "                       [--density <block side>]\n"
+                  << "                       [--analytics-every <generations> [--analytics-log <file>]]\n"
+                  << "                       [--serve unix:<path>|[<host>:]<port>]\n"
+                  << "                       [--roi <top>,<left>,<height>,<width>]]\n"
+                  << "  [--find-loop <max generations>]\n"
+                  << "  [--checkpoint <file written on Ctrl+C>] [--resume <checkpoint>]\n";
+        return 1;
+    }
+    if (!options.workerRing.empty()) {
+        return runSoupWorker(options.workerRing, options.censusPath, options.historyPath, options.soupBudget);
+    }
+    if (options.methuselahs > 0) {
+        return runMethuselahSearch(options);
+    }
+    if (options.soups > 0 && (options.workers > 0 || !options.ringName.empty())) {
+        return runSoupService(options);
+    }
+    if (options.soups > 0) {
+        return runSoupSearch(options);
+    }
+
+    srand(static_cast<unsigned>(options.seed));
+    if (options.roi[2] > 0 && options.roi[3] > 0) {
+        return runRegionOfInterest(options);
+    }
+    if (options.loopSearch > 0) {
+        return runLoopSearch(options);
+    }
+    if (options.universes > 0) {
+        return runBatch(options);
+    }
+    if (options.generations > 0) {
+        return runAdvance(options);
+    }
+
     GameOfLife game;
+    game.setHashInterval(options.hashInterval);
+    game.setCheckpointPath(options.checkpointPath);
+    if (!options.resumePath.empty()) {
+        if (!game.loadCheckpoint(options.resumePath)) {
+            std::cerr << "Failed to read checkpoint " << options.resumePath << "\n";
+            return 1;
+        }
+    } else if (options.patternIndex >= 0) {
+        game.selectPattern(options.patternIndex);
+    }
+    game.setOrientation(options.orientation);
     game.run();
     return 0;
 }
\ No newline at end of file
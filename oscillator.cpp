@@ -0,0 +1,159 @@
+#include <algorithm>
+#include <bit>
+#include <climits>
+#include "oscillator.h"
+
+namespace {
+
+// cells of a component in one word of a row
+struct MaskWord {
+    size_t index {};                            // word in the packed phases
+    uint64_t bits {};
+};
+
+bool test(const std::vector<uint64_t>& words, const int wordsPerRow, const int row, const int col) {
+    return (words[static_cast<size_t>(row) * wordsPerRow + col / 64] >> (col % 64)) & 1;
+}
+
+// labels the 8-connected components of the set cells on the torus, returns the mask
+// words of each component and fills the bounding boxes
+std::vector<std::vector<MaskWord>> findComponents(const Snapshot& layout, const std::vector<uint64_t>& cells,
+                                                  std::vector<OscillatorComponent>& components) {
+    const int rows        = layout.rows;
+    const int cols        = layout.cols;
+    const int wordsPerRow = layout.wordsPerRow;
+    std::vector<uint64_t> visited(cells.size(), 0);
+    std::vector<std::vector<MaskWord>> masks;
+
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < cols; j++) {
+            if (!test(cells, wordsPerRow, i, j) || test(visited, wordsPerRow, i, j)) continue;
+
+            OscillatorComponent component {INT_MAX, INT_MAX, INT_MIN, INT_MIN};
+            std::vector<MaskWord> words;
+            std::vector<std::pair<int, int>> stack {{i, j}};
+            visited[static_cast<size_t>(i) * wordsPerRow + j / 64] |= 1ull << (j % 64);
+
+            while (!stack.empty()) {
+                const auto [row, col] = stack.back();
+                stack.pop_back();
+                const int r = (row % rows + rows) % rows;
+                const int c = (col % cols + cols) % cols;
+                words.push_back({static_cast<size_t>(r) * wordsPerRow + c / 64, 1ull << (c % 64)});
+                component.top    = std::min(component.top, row);
+                component.bottom = std::max(component.bottom, row);
+                component.left   = std::min(component.left, col);
+                component.right  = std::max(component.right, col);
+
+                for (int dRow = -1; dRow <= 1; dRow++) {
+                    for (int dCol = -1; dCol <= 1; dCol++) {
+                        const int nr = ((row + dRow) % rows + rows) % rows;
+                        const int nc = ((col + dCol) % cols + cols) % cols;
+                        if (test(cells, wordsPerRow, nr, nc) && !test(visited, wordsPerRow, nr, nc)) {
+                            visited[static_cast<size_t>(nr) * wordsPerRow + nc / 64] |= 1ull << (nc % 64);
+                            stack.emplace_back(row + dRow, col + dCol);
+                        }
+                    }
+                }
+            }
+
+            // one mask word per word the component touches
+            std::sort(words.begin(), words.end(), [](const auto& a, const auto& b) { return a.index < b.index; });
+            std::vector<MaskWord> mask;
+            for (const auto& word : words) {
+                if (mask.empty() || mask.back().index != word.index) {
+                    mask.push_back(word);
+                } else {
+                    mask.back().bits |= word.bits;
+                }
+            }
+            masks.push_back(std::move(mask));
+
+            // a component that wraps all the way around covers the whole torus in that direction
+            if (component.bottom - component.top >= rows) {
+                component.top    = 0;
+                component.bottom = rows - 1;
+            }
+            if (component.right - component.left >= cols) {
+                component.left  = 0;
+                component.right = cols - 1;
+            }
+            components.push_back(component);
+        }
+    }
+    return masks;
+}
+
+// whether the component repeats after shift generations
+bool repeatsAfter(const std::vector<Snapshot>& phases, const std::vector<MaskWord>& mask, const int shift) {
+    const int period = static_cast<int>(phases.size());
+    for (int k = 0; k < period; k++) {
+        const auto& now   = phases[k].words;
+        const auto& later = phases[(k + shift) % period].words;
+        for (const auto& [index, bits] : mask) {
+            if ((now[index] ^ later[index]) & bits) return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+std::vector<OscillatorComponent> analyzeLoop(const std::vector<Snapshot>& phases) {
+    const int period = static_cast<int>(phases.size());
+    if (period == 0) {
+        return {};
+    }
+
+    // cells alive in some phase and cells alive in every phase
+    std::vector<uint64_t> everAlive(phases[0].words);
+    std::vector<uint64_t> alwaysAlive(phases[0].words);
+    for (const auto& phase : phases) {
+        for (size_t w = 0; w < phase.words.size(); w++) {
+            everAlive[w]   |= phase.words[w];
+            alwaysAlive[w] &= phase.words[w];
+        }
+    }
+
+    std::vector<OscillatorComponent> components;
+    const auto masks = findComponents(phases[0], everAlive, components);
+
+    for (size_t k = 0; k < components.size(); k++) {
+        OscillatorComponent& component = components[k];
+        const auto& mask = masks[k];
+
+        for (const auto& [index, bits] : mask) {
+            component.stator += std::popcount(bits & alwaysAlive[index]);
+            component.rotor  += std::popcount(bits & ~alwaysAlive[index]);
+        }
+
+        long long changes = 0;
+        component.minCells = INT_MAX;
+        for (int g = 0; g < period; g++) {
+            const auto& now  = phases[g].words;
+            const auto& next = phases[(g + 1) % period].words;
+            int cells = 0;
+            for (const auto& [index, bits] : mask) {
+                cells   += std::popcount(now[index] & bits);
+                changes += std::popcount((now[index] ^ next[index]) & bits);
+            }
+            component.minCells = std::min(component.minCells, cells);
+            component.maxCells = std::max(component.maxCells, cells);
+        }
+        component.heat = static_cast<double>(changes) / period;
+
+        // the period of a component divides the period of the whole grid
+        component.period = period;
+        for (int shift = 1; shift < period; shift++) {
+            if (period % shift == 0 && repeatsAfter(phases, mask, shift)) {
+                component.period = shift;
+                break;
+            }
+        }
+    }
+
+    std::stable_sort(components.begin(), components.end(), [](const auto& a, const auto& b) {
+        return a.rotor + a.stator > b.rotor + b.stator;
+    });
+    return components;
+}
@@ -0,0 +1,26 @@
+#ifndef OSCILLATOR_H
+#define OSCILLATOR_H
+
+#include <vector>
+#include "snapshot.h"
+
+// one group of cells that were alive at some point of the period and touch each other
+struct OscillatorComponent {
+    int top    {};                              // bounding box, coordinates unwrapped across edges
+    int left   {};
+    int bottom {};
+    int right  {};
+    int period {};                              // smallest period of the component alone
+    int minCells {};                            // population over the period
+    int maxCells {};
+    int rotor  {};                              // cells that change during the period
+    int stator {};                              // cells alive in every phase
+    double heat {};                             // average cells changing per generation
+};
+
+// splits the cells ever alive during the period into 8-connected components and measures
+// each of them with word-wide operations on the phases, one snapshot per generation of the
+// period, largest components first
+std::vector<OscillatorComponent> analyzeLoop(const std::vector<Snapshot>& phases);
+
+#endif
@@ -1,80 +1,222 @@
-#include <vector>
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <utility>
 #include "patterns.h"
 
-const std::vector<Pattern> PATTERNS = {
+namespace {
+
+using Cell = std::pair<int, int>;               // row and column relative to the center
+
+// moves a cell to one of the 8 orientations, see PatternShape
+constexpr Cell orient(const Cell& cell, const int orientation) {
+    auto [row, col] = cell;
+    if (orientation >= 4) col = -col;
+    for (int turn = 0; turn < orientation % 4; turn++) {
+        const int previous = row;
+        row = col;
+        col = -previous;
+    }
+    return {row, col};
+}
+
+// bounding boxes of the 8 orientations of a pattern and where their words start
+struct Layout {
+    std::array<PatternBitmap, 8> bitmaps {};    // words not assigned yet
+    std::array<size_t, 8> offsets {};
+    size_t words {};                            // total of all orientations
+};
+
+template <size_t N>
+constexpr Layout layoutOf(const std::array<Cell, N>& cells) {
+    Layout layout;
+    for (int orientation = 0; orientation < 8; orientation++) {
+        int top = INT_MAX, left = INT_MAX, bottom = INT_MIN, right = INT_MIN;
+        for (const Cell& cell : cells) {
+            const auto [row, col] = orient(cell, orientation);
+            top    = std::min(top, row);
+            bottom = std::max(bottom, row);
+            left   = std::min(left, col);
+            right  = std::max(right, col);
+        }
+
+        PatternBitmap& bitmap = layout.bitmaps[orientation];
+        bitmap.top         = top;
+        bitmap.left        = left;
+        bitmap.height      = bottom - top + 1;
+        bitmap.width       = right - left + 1;
+        bitmap.wordsPerRow = (bitmap.width + 63) / 64;
+        layout.offsets[orientation] = layout.words;
+        layout.words += static_cast<size_t>(bitmap.height) * bitmap.wordsPerRow;
+    }
+    return layout;
+}
+
+// sets the bits of all orientations; a repeated cell stops the compilation
+template <size_t WORDS, size_t N>
+constexpr std::array<uint64_t, WORDS> packCells(const std::array<Cell, N>& cells, const Layout& layout) {
+    std::array<uint64_t, WORDS> words {};
+    for (int orientation = 0; orientation < 8; orientation++) {
+        const PatternBitmap& bitmap = layout.bitmaps[orientation];
+        for (const Cell& cell : cells) {
+            const auto [row, col] = orient(cell, orientation);
+            const int c = col - bitmap.left;
+            const size_t index = layout.offsets[orientation] +
+                                 static_cast<size_t>(row - bitmap.top) * bitmap.wordsPerRow + c / 64;
+            const uint64_t bit = 1ull << (c % 64);
+            if (words[index] & bit) {
+                throw "a built-in pattern lists the same cell twice";
+            }
+            words[index] |= bit;
+        }
+    }
+    return words;
+}
+
+// bitmaps of a built-in pattern, computed by the compiler and stored in read-only data
+template <const auto& CELLS>
+struct CompiledPattern {
+    static constexpr Layout LAYOUT = layoutOf(CELLS);
+    static constexpr std::array<uint64_t, LAYOUT.words> WORDS = packCells<LAYOUT.words>(CELLS, LAYOUT);
+
+    static constexpr PatternShape build() {
+        std::array<PatternBitmap, 8> bitmaps = LAYOUT.bitmaps;
+        for (int orientation = 0; orientation < 8; orientation++) {
+            bitmaps[orientation].words = WORDS.data() + LAYOUT.offsets[orientation];
+        }
+        return {bitmaps, static_cast<int>(CELLS.size())};
+    }
+    static constexpr PatternShape SHAPE = build();
+};
+
+constexpr auto CUBE_3X3 = std::to_array<Cell>({
+    {-1, -1}, {-1, 0}, {-1, 1},
+    {0, -1},  {0, 0},   {0, 1},
+    {1, -1},  {1, 0},   {1, 1}
+});
+
+constexpr auto CUBE_4X4 = std::to_array<Cell>({
+    {-2, -2}, {-2, -1}, {-2, 0}, {-2, 1},
+    {-1, -2}, {-1, -1}, {-1, 0}, {-1, 1},
+    {0, -2},  {0, -1},  {0, 0},   {0, 1},
+    {1, -2},  {1, -1},  {1, 0},   {1, 1}
+});
+
+constexpr auto CUBE_5X5 = std::to_array<Cell>({
+    {-2, -2}, {-2, -1}, {-2, 0}, {-2, 1}, {-2, 2},
+    {-1, -2}, {-1, -1}, {-1, 0}, {-1, 1}, {-1, 2},
+    {0, -2},  {0, -1},  {0, 0},   {0, 1}, {0, 2},
+    {1, -2},  {1, -1},  {1, 0},   {1, 1},  {1, 2},
+    {2, -2},  {2, -1},  {2, 0},   {2, 1},  {2, 2}
+});
+
+constexpr auto BLINKER = std::to_array<Cell>({
+    {0, -1},   {0, 0},      {0, 1},
+    {-10, -1}, {-10, 0},  {-10, 1},
+    {10, -1},  {10, 0},    {10, 1},
+    {5, -11},  {5, -10},   {5, -9},
+    {5, 11},   {5, 10},     {5, 9},
+    {-5, -11}, {-5, -10}, {-5, -9},
+    {-5, 11},  {-5, 10},   {-5, 9}
+});
+
+constexpr auto GLIDER = std::to_array<Cell>({
+    {-1, 0},   {0, 1},    {1, -1},   {1, 0},       {1, 1},
+    {-6, -30}, {-5, -29}, {-4, -31}, {-4, -30}, {-4, -29},
+    {-1, 20},  {0, 21},   {-1, 19},  {1, 20},    {-1, 21},
+    {-11, 5},  {-10, 4},  {-9, 4},   {-9, 5},     {-9, 6},
+    {14, -30}, {15, -31}, {16, -31}, {16, -30}, {16, -29},
+    {29, 10},  {30, 9},   {29, 9},   {31, 10},   {29, 11}
+});
+
+constexpr auto BLOCK_AND_GLIDER = std::to_array<Cell>({
+    {-1, -2}, {-1, -1}, {0, -2}, {0, 0}, {1, 0}, {1, 1}
+});
+
+constexpr auto ANGEL = std::to_array<Cell>({
+    {-1, 0}, {0, -2}, {0, -1}, {0, 1}, {0, 2}, {1, -1}, {1, 1}, {2, 0}
+});
+
+constexpr auto LOVE = std::to_array<Cell>({
+    {-4, -3}, {-4, -2},
+    {-4, 3},  {-4, 2},
+    {-3, -4}, {-3, -3}, {-3, -2}, {-3, -1},
+    {-3, 4},  {-3, 3},  {-3, 2},  {-3, 1},
+    {-2, -4}, {-2, -3}, {-2, -2}, {-2, -1}, {-2, 0},
+    {-2, 4},  {-2, 3},  {-2, 2},  {-2, 1},
+    {-1, -4}, {-1, -3}, {-1, -2}, {-1, -1}, {-1, 0},
+    {-1, 4},  {-1, 3},  {-1, 2},  {-1, 1},
+    {0, -4},  {0, -3},  {0, -2},  {0, -1}, {0, 0},
+    {0, 4},   {0, 3},   {0, 2},   {0, 1},
+    {1, -3},  {1, -2},  {1, -1},  {1, 0},
+    {1, 3},   {1, 2},   {1, 1},
+    {2, -2},  {2, -1},  {2, 0},
+    {2, 2},   {2, 1},
+    {3, -1},  {3, 1},   {3, 0},
+    {4, 0}
+});
+
+constexpr auto GLIDERS_BY_THE_DOZEN = std::to_array<Cell>({
+    {-1, -2}, {-1, -1}, {-1, 2}, {0, -2},
+    {0, 2},   {1, -2},  {1, 1},   {1, 2}
+});
+
+constexpr auto DIAMOND_4_8_12 = std::to_array<Cell>({
+    {-4, -2}, {-4, -1}, {-4, 0}, {-4, 1},
+    {4, -2},  {4, -1},  {4, 0},   {4, 1},
+    {-2, -4}, {-2, -3}, {-2, -2}, {-2, -1}, {-2, 0}, {-2, 1}, {-2, 2}, {-2, 3},
+    {2, -4},  {2, -3},  {2, -2},  {2, -1},  {2, 0},  {2, 1},  {2, 2},   {2, 3},
+    {0, -6},  {0, -5},  {0, -4},  {0, -3}, {0, -2}, {0, -1},
+    {0, 0},   {0, 1},   {0, 2},   {0, 3},  {0, 4},   {0, 5}
+});
+
+constexpr auto PENTADECATHLON = std::to_array<Cell>({
+    {0, -5}, {0, -4}, {0, -3}, {0, -2}, {0, -1},
+    {0, 0},  {0, 1},  {0, 2},  {0, 3},   {0, 4}
+});
+
+constexpr auto PRE_PULSAR = std::to_array<Cell>({
+    {-1, -4}, {-1, -3}, {-1, -2}, {-1, 2}, {-1, 3}, {-1, 4},
+    {0, -4},  {0, -2},                     {0, 2},   {0, 4},
+    {1, -4},  {1, -3},  {1, -2},  {1, 2},  {1, 3},   {1, 4}
+});
+
+constexpr auto ACHIMS_P16 = std::to_array<Cell>({
+    {-6, 1}, {-6, 2},  {-5, 1},  {-5, 3},  {-4, 1},  {-4, 3},  {-4, 4},  {-4, -4},
+    {-3, 2}, {-3, -4}, {-3, -5}, {-2, -3}, {-2, -6}, {-1, -4}, {-1, -5}, {-1, -6},
+    {1, 4},  {1, 5},   {1, 6},   {2, 3},   {2, 6},   {3, -2},  {3, 4},     {3, 5},
+    {4, -1}, {4, -3},  {4, -4},  {4, 4},   {5, -1},  {5, -3},  {6, -1},   {6, -2}
+});
+
+constexpr auto GOSPER_GUN_SYNTHESIS = std::to_array<Cell>({
+    {-7, -10}, {-6, -10}, {-6, -8},  {-6, 9},   {-5, -10},
+    {-5, -9},  {-5, 9},   {-5, 11},  {-4, -26}, {-4, -24},
+    {-4, -13}, {-4, 9},   {-4, 10},  {-3, -25}, {-3, -24},
+    {-3, -12}, {-3, -11}, {-2, -25}, {-2, -13}, {-2, -12},
+    {1, -16},  {1, -15},  {1, 6},    {1, 7},     {2, -15},
+    {2, -14},  {2, 6},    {2, 8},    {2, 18},     {2, 19},
+    {2, 20},   {3, -16},  {3, 6},    {3, 18},      {4, 1},
+    {4, 19},   {5, 1},    {5, 2},    {6, 0},       {6, 2}
+});
+
+constexpr BuiltinPattern BUILTIN_PATTERNS[] {
     {"Random", {}},
-    {"3x3 Cube", {{-1, -1}, {-1, 0}, {-1, 1},
-                  {0, -1},  {0, 0},   {0, 1},
-                  {1, -1},  {1, 0},   {1, 1}}},
-    {"4x4 Cube", {{-2, -2}, {-2, -1}, {-2, 0}, {-2, 1},
-                  {-1, -2}, {-1, -1}, {-1, 0}, {-1, 1},
-                  {0, -2},  {0, -1},  {0, 0},   {0, 1},
-                  {1, -2},  {1, -1},  {1, 0},   {1, 1}}},
-    {"5x5 Cube", {{-2, -2}, {-2, -1}, {-2, 0}, {-2, 1}, {-2, 2},
-                  {-1, -2}, {-1, -1}, {-1, 0}, {-1, 1}, {-1, 2},
-                  {0, -2},  {0, -1},  {0, 0},   {0, 1}, {-0, 2},
-                  {1, -2},  {1, -1},  {1, 0},   {1, 1},  {1, 2},
-                  {2, -2},  {2, -1},  {2, 0},   {2, 1},  {2, 2}}},
-    {"Blinker", {{0, -1},   {0, 0},      {0, 1},
-                 {-10, -1}, {-10, 0},  {-10, 1},
-                 {10, -1},  {10, 0},    {10, 1},
-                 {5, -11},  {5, -10},   {5, -9},
-                 {5, 11},   {5, 10},     {5, 9},
-                 {-5, -11}, {-5, -10}, {-5, -9},
-                 {-5, 11},  {-5, 10},   {-5, 9}}},
-    {"Glider", {
-        {-1, 0},   {0, 1},    {1, -1},   {1, 0},       {1, 1},
-        {-6, -30}, {-5, -29}, {-4, -31}, {-4, -30}, {-4, -29},
-        {-1, 20},  {0, 21},   {-1, 19},  {1, 20},    {-1, 21},
-        {-11, 5},  {-10, 4},  {-9, 4},   {-9, 5},     {-9, 6},
-        {14, -30}, {15, -31}, {16, -31}, {16, -30}, {16, -29},
-        {29, 10},  {30, 9},   {29, 9},   {31, 10},   {29, 11}
-    }},
-    {"Block and Glider", {{-1, -2}, {-1, -1}, {0, -2}, {0, 0}, {1, 0}, {1, 1}}},
-    {"Angel", {{-1, 0}, {0, -2}, {0, -1}, {0, 1}, {0, 2}, {1, -1}, {1, 1}, {2, 0}}},
-    {"Love", {
-        {-4, -3}, {-4, -2},
-        {-4, 3},  {-4, 2},
-        {-3, -4}, {-3, -3}, {-3, -2}, {-3, -1},
-        {-3, 4},  {-3, 3},  {-3, 2},  {-3, 1},
-        {-2, -4}, {-2, -3}, {-2, -2}, {-2, -1}, {-2, 0},
-        {-2, 4},  {-2, 3},  {-2, 2},  {-2, 1},
-        {-1, -4}, {-1, -3}, {-1, -2}, {-1, -1}, {-1, 0},
-        {-1, 4},  {-1, 3},  {-1, 2},  {-1, 1},
-        {0, -4},  {0, -3},  {0, -2},  {0, -1}, {0, 0},
-        {0, 4},   {0, 3},   {0, 2},   {0, 1},
-        {1, -3},  {1, -2},  {1, -1},  {1, 0},
-        {1, 3},   {1, 2},   {1, 1},
-        {2, -2},  {2, -1},  {2, 0},
-        {2, 2},   {2, 1},
-        {3, -1},  {3, 1},   {3, 0},
-        {4, 0}
-    }},
-    {"Gliders by the Dozen", {{-1, -2}, {-1, -1}, {-1, 2}, {0, -2},
-                              {0, 2},   {1, -2},  {1, 1},   {1, 2}}},
-    {"4-8-12 Diamond", {{-4, -2}, {-4, -1}, {-4, 0}, {-4, 1},
-                        {4, -2},  {4, -1},  {4, 0},   {4, 1},
-                        {-2, -4}, {-2, -3}, {-2, -2}, {-2, -1}, {-2, 0}, {-2, 1}, {-2, 2}, {-2, 3},
-                        {2, -4},  {2, -3},  {2, -2},  {2, -1},  {2, 0},  {2, 1},  {2, 2},   {2, 3},
-                        {0, -6},  {0, -5},  {0, -4},  {0, -3}, {0, -2}, {0, -1},
-                        {0, 0},   {0, 1},   {0, 2},   {0, 3},  {0, 4},   {0, 5}}},
-    {"Unidimensional Pentadecathlon", {{0, -5}, {0, -4}, {0, -3}, {0, -2}, {0, -1},
-                                       {0, 0},  {0, 1},  {0, 2},  {0, 3},   {0, 4}}},
-    {"Pre-Pulsar", {{-1, -4}, {-1, -3}, {-1, -2}, {-1, 2}, {-1, 3}, {-1, 4},
-                    {0, -4},  {0, -2},                     {0, 2},   {0, 4},
-                    {1, -4},  {1, -3},  {1, -2},  {1, 2},  {1, 3},   {1, 4}}},
-    {"Achim's p16", {{-6, 1}, {-6, 2},  {-5, 1},  {-5, 3},  {-4, 1},  {-4, 3},  {-4, 4},  {-4, -4},
-                     {-3, 2}, {-3, -4}, {-3, -5}, {-2, -3}, {-2, -6}, {-1, -4}, {-1, -5}, {-1, -6},
-                     {1, 4},  {1, 5},   {1, 6},   {2, 3},   {2, 6},   {3, -2},  {3, 4},     {3, 5},
-                     {4, -1}, {4, -3},  {4, -4},  {4, 4},   {5, -1},  {5, -3},  {6, -1},   {6, -2}}},
-    {"Gosper Glider Gun Synthesis", {
-        {-7, -10}, {-6, -10}, {-6, -8},  {-6, 9},   {-5, -10},
-        {-5, -9},  {-5, 9},   {-5, 11},  {-4, -26}, {-4, -24},
-        {-4, -13}, {-4, 9},   {-4, 10},  {-3, -25}, {-3, -24},
-        {-3, -12}, {-3, -11}, {-2, -25}, {-2, -13}, {-2, -12},
-        {1, -16},  {1, -15},  {1, 6},    {1, 7},     {2, -15},
-        {2, -14},  {2, 6},    {2, 8},    {2, 18},     {2, 19},
-        {2, 20},   {3, -16},  {3, 6},    {3, 18},      {4, 1},
-        {4, 19},   {5, 1},    {5, 2},    {6, 0},       {6, 2}
-    }}
-};
\ No newline at end of file
+    {"3x3 Cube", CompiledPattern<CUBE_3X3>::SHAPE},
+    {"4x4 Cube", CompiledPattern<CUBE_4X4>::SHAPE},
+    {"5x5 Cube", CompiledPattern<CUBE_5X5>::SHAPE},
+    {"Blinker", CompiledPattern<BLINKER>::SHAPE},
+    {"Glider", CompiledPattern<GLIDER>::SHAPE},
+    {"Block and Glider", CompiledPattern<BLOCK_AND_GLIDER>::SHAPE},
+    {"Angel", CompiledPattern<ANGEL>::SHAPE},
+    {"Love", CompiledPattern<LOVE>::SHAPE},
+    {"Gliders by the Dozen", CompiledPattern<GLIDERS_BY_THE_DOZEN>::SHAPE},
+    {"4-8-12 Diamond", CompiledPattern<DIAMOND_4_8_12>::SHAPE},
+    {"Unidimensional Pentadecathlon", CompiledPattern<PENTADECATHLON>::SHAPE},
+    {"Pre-Pulsar", CompiledPattern<PRE_PULSAR>::SHAPE},
+    {"Achim's p16", CompiledPattern<ACHIMS_P16>::SHAPE},
+    {"Gosper Glider Gun Synthesis", CompiledPattern<GOSPER_GUN_SYNTHESIS>::SHAPE},
+};
+
+} // namespace
+
+constinit const std::span<const BuiltinPattern> PATTERNS {BUILTIN_PATTERNS};
@@ -1,14 +1,61 @@
 #ifndef PATTERNS_H
 #define PATTERNS_H
 
+#include <array>
+#include <cstdint>
+#include <span>
 #include <string>
-#include <vector>
+#include <string_view>
+
+// cells of one orientation of a pattern, one bit per cell of the bounding box, packed
+// 64 per word, LSB first, each row starting at a new word
+struct PatternBitmap {
+    int top         {};                         // bounding box relative to the pattern center
+    int left        {};
+    int height      {};
+    int width       {};
+    int wordsPerRow {};
+    const uint64_t* words {};                   // height * wordsPerRow words in static storage
+
+    constexpr bool get(const int row, const int col) const {
+        return (words[static_cast<size_t>(row) * wordsPerRow + col / 64] >> (col % 64)) & 1;
+    }
+};
+
+/*
+ * PatternShape - cells of a pattern in all 8 orientations.
+ *
+ * Orientations 0-3 are the pattern rotated clockwise by 0, 90, 180 and 270 degrees,
+ * 4-7 the same after mirroring left to right. Shapes only refer to bitmaps compiled
+ * into the program (see patterns.cpp), so copying one is cheap.
+ */
+class PatternShape {
+    std::array<PatternBitmap, 8> orientations {};
+    int population {};                          // distinct alive cells
+
+public:
+    constexpr PatternShape() = default;
+    constexpr PatternShape(const std::array<PatternBitmap, 8>& orientations, const int population)
+        : orientations(orientations), population(population) {}
+
+    constexpr const PatternBitmap& oriented(const int orientation) const { return orientations[orientation & 7]; }
+    constexpr int getPopulation() const { return population; }
+    constexpr bool empty() const { return population == 0; }
+};
 
 struct Pattern {
     std::string name;                           // name of the pattern
-    std::vector<std::pair<int, int>> cells;     // cell coordinates relative to center
+    PatternShape shape;                         // cells relative to center
+};
+
+// predefined pattern, built at compile time
+struct BuiltinPattern {
+    std::string_view name;
+    PatternShape shape;
+
+    Pattern toPattern() const { return {std::string(name), shape}; }
 };
 
-extern const std::vector<Pattern> PATTERNS;     // collection of predefined patterns
+extern const std::span<const BuiltinPattern> PATTERNS;  // collection of predefined patterns
 
 #endif
@@ -0,0 +1,439 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <string_view>
+#include <netdb.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "remote.h"
+
+namespace {
+
+constexpr std::string_view STREAM_MAGIC {"GOLSTRM1"};   // starts the hello
+constexpr uint64_t MAX_STREAM_CELLS {1ull << 28};       // larger boards are refused by viewers
+constexpr int SEND_POLL_MS {100};               // wait for room in the socket buffer
+constexpr int STALL_MS {10000};                 // a viewer taking nothing for this long is dropped
+constexpr size_t MAX_VARINT_BYTES {10};
+constexpr size_t RECEIVE_CHUNK {1 << 16};       // bytes a viewer asks the socket for at once
+
+// splits "unix:<path>" or "[host:]port"; host is empty for all interfaces
+struct Address {
+    bool unixSocket {};
+    std::string path;
+    std::string host;
+    std::string port;
+};
+
+Address parseAddress(const std::string& text) {
+    Address address;
+    if (text.starts_with("unix:")) {
+        address.unixSocket = true;
+        address.path = text.substr(5);
+        return address;
+    }
+    const auto colon = text.rfind(':');
+    if (colon == std::string::npos) {
+        address.port = text;
+    } else {
+        address.host = text.substr(0, colon);
+        address.port = text.substr(colon + 1);
+    }
+    return address;
+}
+
+// fills a Unix socket address, returns false if the path does not fit
+bool unixAddress(const std::string& path, sockaddr_un& address) {
+    address = {};
+    address.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+        return false;
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    return true;
+}
+
+// opens a TCP socket bound (listening) or connected to the address, -1 on failure
+int openTcp(const Address& address, const bool listening) {
+    addrinfo hints {};
+    hints.ai_family   = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags    = listening ? AI_PASSIVE : 0;
+    addrinfo* results = nullptr;
+    if (getaddrinfo(address.host.empty() ? nullptr : address.host.c_str(), address.port.c_str(),
+                    &hints, &results) != 0) {
+        return -1;
+    }
+
+    int fd = -1;
+    for (const addrinfo* entry = results; entry != nullptr && fd == -1; entry = entry->ai_next) {
+        fd = ::socket(entry->ai_family, entry->ai_socktype, entry->ai_protocol);
+        if (fd == -1) continue;
+        const int reuse = 1;
+        const bool ok = listening
+            ? setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) == 0 &&
+              bind(fd, entry->ai_addr, entry->ai_addrlen) == 0 && ::listen(fd, 1) == 0
+            : ::connect(fd, entry->ai_addr, entry->ai_addrlen) == 0;
+        if (!ok) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+    freeaddrinfo(results);
+    return fd;
+}
+
+// writes everything, waiting for room in the socket buffer but giving up on a stalled peer
+bool writeAll(const int fd, const char* data, size_t size) {
+    int stalledMs = 0;
+    while (size > 0) {
+        const ssize_t written = ::send(fd, data, size, MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (written > 0) {
+            data += written;
+            size -= static_cast<size_t>(written);
+            stalledMs = 0;
+            continue;
+        }
+        if (written < 0 && errno == EINTR) continue;
+        if (written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            pollfd output {fd, POLLOUT, 0};
+            if (poll(&output, 1, SEND_POLL_MS) == 0 && (stalledMs += SEND_POLL_MS) >= STALL_MS) {
+                return false;
+            }
+            continue;
+        }
+        return false;
+    }
+    return true;
+}
+
+// reads exactly size bytes; an interrupting signal ends the stream like a closed socket
+bool readAll(const int fd, char* data, size_t size) {
+    while (size > 0) {
+        const ssize_t received = ::recv(fd, data, size, 0);
+        if (received <= 0) {
+            return false;
+        }
+        data += received;
+        size -= static_cast<size_t>(received);
+    }
+    return true;
+}
+
+void putUint32(std::string& out, const uint32_t value, const size_t at) {
+    for (int k = 0; k < 4; k++) {
+        out[at + k] = static_cast<char>((value >> (8 * k)) & 0xff);
+    }
+}
+
+uint32_t getUint32(const char* in) {
+    uint32_t value = 0;
+    for (int k = 0; k < 4; k++) {
+        value |= static_cast<uint32_t>(static_cast<unsigned char>(in[k])) << (8 * k);
+    }
+    return value;
+}
+
+void putVarint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+void putWord(std::string& out, const uint64_t word) {
+    for (int k = 0; k < 8; k++) {
+        out.push_back(static_cast<char>((word >> (8 * k)) & 0xff));
+    }
+}
+
+// reads a message payload front to back, failing on anything that runs past its end
+class PayloadReader {
+    std::string_view payload;
+    size_t position {};
+
+public:
+    explicit PayloadReader(const std::string_view payload) : payload(payload) {}
+
+    bool varint(uint64_t& value) {
+        value = 0;
+        for (size_t k = 0; k < MAX_VARINT_BYTES && position < payload.size(); k++) {
+            const auto byte = static_cast<unsigned char>(payload[position++]);
+            value |= static_cast<uint64_t>(byte & 0x7f) << (7 * k);
+            if ((byte & 0x80) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool word(uint64_t& value) {
+        if (payload.size() - position < 8) {
+            return false;
+        }
+        value = 0;
+        for (int k = 0; k < 8; k++) {
+            value |= static_cast<uint64_t>(static_cast<unsigned char>(payload[position++])) << (8 * k);
+        }
+        return true;
+    }
+
+    bool done() const {
+        return position == payload.size();
+    }
+};
+
+// largest payload a board of the given number of words can need: four counters and
+// a pair of run lengths with a word for every word
+size_t maxPayload(const size_t words) {
+    return (4 + 2 * (words + 1)) * MAX_VARINT_BYTES + words * 8;
+}
+
+} // namespace
+
+std::unique_ptr<StreamServer> StreamServer::listen(const std::string& text, const int rows, const int cols) {
+    const Address address = parseAddress(text);
+    std::unique_ptr<StreamServer> server(new StreamServer());
+    server->rows = rows;
+    server->cols = cols;
+
+    if (address.unixSocket) {
+        sockaddr_un socketAddress;
+        if (!unixAddress(address.path, socketAddress)) {
+            return nullptr;
+        }
+        server->listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (server->listener == -1) {
+            return nullptr;
+        }
+        // a socket left behind by an earlier run is replaced, anything else is kept
+        struct stat existing;
+        if (::lstat(address.path.c_str(), &existing) == 0) {
+            if (!S_ISSOCK(existing.st_mode)) {
+                return nullptr;
+            }
+            ::unlink(address.path.c_str());
+        }
+        if (bind(server->listener, reinterpret_cast<const sockaddr*>(&socketAddress), sizeof(socketAddress)) != 0) {
+            return nullptr;
+        }
+        server->socketPath = address.path;
+        if (::listen(server->listener, 1) != 0) {
+            return nullptr;
+        }
+    } else {
+        server->listener = openTcp(address, true);
+        if (server->listener == -1) {
+            return nullptr;
+        }
+    }
+    return server;
+}
+
+StreamServer::~StreamServer() {
+    dropViewer();
+    if (listener != -1) {
+        ::close(listener);
+    }
+    if (!socketPath.empty()) {
+        ::unlink(socketPath.c_str());
+    }
+}
+
+void StreamServer::dropViewer() {
+    if (viewer != -1) {
+        ::close(viewer);
+        viewer = -1;
+    }
+}
+
+bool StreamServer::waitForViewer(const int timeoutMs) {
+    if (viewer != -1) {
+        return true;
+    }
+    pollfd input {listener, POLLIN, 0};
+    if (poll(&input, 1, timeoutMs) <= 0) {
+        return false;
+    }
+    viewer = ::accept(listener, nullptr, nullptr);
+    if (viewer == -1) {
+        return false;
+    }
+
+    std::string hello(STREAM_MAGIC);
+    hello.append(8, '\0');
+    putUint32(hello, static_cast<uint32_t>(rows), STREAM_MAGIC.size());
+    putUint32(hello, static_cast<uint32_t>(cols), STREAM_MAGIC.size() + 4);
+    if (!writeAll(viewer, hello.data(), hello.size())) {
+        dropViewer();
+        return false;
+    }
+    sent.assign(static_cast<size_t>(rows) * ((cols + 63) / 64), 0);    // the viewer starts empty
+    return true;
+}
+
+bool StreamServer::send(const Snapshot& snapshot) {
+    if (viewer == -1) {
+        return false;
+    }
+
+    message.assign(4, '\0');
+    putVarint(message, static_cast<uint64_t>(snapshot.generation));
+    putVarint(message, static_cast<uint64_t>(snapshot.aliveCells));
+    putVarint(message, static_cast<uint64_t>(snapshot.totalBirths));
+    putVarint(message, static_cast<uint64_t>(snapshot.totalDeaths));
+
+    // alternating runs of unchanged and changed words, most of a board being unchanged
+    const size_t total = sent.size();
+    for (size_t k = 0; k < total; ) {
+        size_t same = 0;
+        while (k + same < total && snapshot.words[k + same] == sent[k + same]) same++;
+        size_t changed = 0;
+        while (k + same + changed < total && snapshot.words[k + same + changed] != sent[k + same + changed]) {
+            changed++;
+        }
+
+        putVarint(message, same);
+        putVarint(message, changed);
+        for (size_t w = k + same; w < k + same + changed; w++) {
+            putWord(message, snapshot.words[w] ^ sent[w]);
+            sent[w] = snapshot.words[w];
+        }
+        k += same + changed;
+    }
+    putUint32(message, static_cast<uint32_t>(message.size() - 4), 0);
+
+    if (!writeAll(viewer, message.data(), message.size())) {
+        dropViewer();
+        return false;
+    }
+    return true;
+}
+
+std::unique_ptr<StreamClient> StreamClient::connect(const std::string& text) {
+    const Address address = parseAddress(text);
+    std::unique_ptr<StreamClient> client(new StreamClient());
+
+    if (address.unixSocket) {
+        sockaddr_un socketAddress;
+        if (!unixAddress(address.path, socketAddress)) {
+            return nullptr;
+        }
+        client->socket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (client->socket == -1 ||
+            ::connect(client->socket, reinterpret_cast<const sockaddr*>(&socketAddress), sizeof(socketAddress)) != 0) {
+            return nullptr;
+        }
+    } else {
+        client->socket = openTcp(address, false);
+        if (client->socket == -1) {
+            return nullptr;
+        }
+    }
+
+    char hello[STREAM_MAGIC.size() + 8];
+    if (!readAll(client->socket, hello, sizeof(hello)) ||
+        std::string_view(hello, STREAM_MAGIC.size()) != STREAM_MAGIC) {
+        return nullptr;
+    }
+    const uint32_t rows = getUint32(hello + STREAM_MAGIC.size());
+    const uint32_t cols = getUint32(hello + STREAM_MAGIC.size() + 4);
+    if (rows == 0 || cols == 0 || static_cast<uint64_t>(rows) * cols > MAX_STREAM_CELLS) {
+        return nullptr;
+    }
+
+    Snapshot& current = client->current;
+    current.rows        = static_cast<int>(rows);
+    current.cols        = static_cast<int>(cols);
+    current.wordsPerRow = static_cast<int>((cols + 63) / 64);
+    current.words.assign(static_cast<size_t>(rows) * current.wordsPerRow, 0);
+    return client;
+}
+
+StreamClient::~StreamClient() {
+    if (socket != -1) {
+        ::close(socket);
+    }
+}
+
+size_t StreamClient::queuedMessage() const {
+    const size_t queued = received.size() - start;
+    if (queued < 4) {
+        return 0;
+    }
+    const size_t size = 4 + static_cast<size_t>(getUint32(received.data() + start));
+    return queued >= size ? size : 0;
+}
+
+bool StreamClient::fill(const bool wait) {
+    if (start > 0) {
+        received.erase(0, start);
+        start = 0;
+    }
+    const size_t size = received.size();
+    received.resize(size + RECEIVE_CHUNK);
+    const ssize_t count = ::recv(socket, received.data() + size, RECEIVE_CHUNK, wait ? 0 : MSG_DONTWAIT);
+    received.resize(size + static_cast<size_t>(std::max<ssize_t>(count, 0)));
+    return count > 0;
+}
+
+bool StreamClient::receive() {
+    // an interrupting signal ends the stream like a closed socket
+    size_t size = 0;
+    while (true) {
+        if (received.size() - start >= 4 && getUint32(received.data() + start) > maxPayload(current.words.size())) {
+            return false;
+        }
+        if ((size = queuedMessage()) > 0) break;
+        if (!fill(true)) {
+            return false;
+        }
+    }
+    const std::string_view payload(received.data() + start + 4, size - 4);
+    start += size;
+
+    PayloadReader reader(payload);
+    uint64_t counters[4];
+    for (uint64_t& counter : counters) {
+        if (!reader.varint(counter) || counter > INT32_MAX) {
+            return false;
+        }
+    }
+
+    const size_t total = current.words.size();
+    for (size_t k = 0; k < total; ) {
+        uint64_t same = 0, changed = 0;
+        if (!reader.varint(same) || !reader.varint(changed) || same > total - k || changed > total - k - same ||
+            same + changed == 0) {
+            return false;
+        }
+        k += same;
+        for (uint64_t w = 0; w < changed; w++, k++) {
+            uint64_t delta = 0;
+            if (!reader.word(delta)) {
+                return false;
+            }
+            current.words[k] ^= delta;
+        }
+    }
+    if (!reader.done()) {
+        return false;
+    }
+
+    current.generation  = static_cast<int>(counters[0]);
+    current.aliveCells  = static_cast<int>(counters[1]);
+    current.totalBirths = static_cast<int>(counters[2]);
+    current.totalDeaths = static_cast<int>(counters[3]);
+    current.version++;
+    return true;
+}
+
+bool StreamClient::pending() {
+    if (queuedMessage() == 0) {
+        fill(false);
+    }
+    return queuedMessage() > 0;
+}
@@ -0,0 +1,94 @@
+#ifndef REMOTE_H
+#define REMOTE_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "snapshot.h"
+
+/*
+ * Remote stream - generations sent from a simulation to a viewer over a socket.
+ *
+ * Addresses are "unix:<path>" for a Unix socket or "[host:]port" for TCP. After
+ * connecting, the server sends a hello ("GOLSTRM1", rows and columns as 32-bit
+ * little-endian) and then one message per generation it chooses to send:
+ *
+ *   length    32-bit little-endian size of the rest of the message
+ *   varints   generation, alive cells, total births, total deaths
+ *   runs      over the packed words of the snapshot XORed with the previous message:
+ *             varint count of unchanged words, varint count of changed words, then
+ *             that many words as 64-bit little-endian, until every word is covered
+ *
+ * The first message after connecting is relative to an empty board. A server never
+ * queues generations: while a message is being sent newer ones are simply skipped,
+ * so a slow link gets fewer generations rather than an ever longer backlog.
+ */
+
+// listens for one viewer at a time and sends it snapshots as deltas
+class StreamServer {
+    int listener {-1};
+    int viewer   {-1};
+    std::string socketPath;                     // Unix socket removed on destruction
+    int rows {};
+    int cols {};
+    std::vector<uint64_t> sent;                 // words the viewer has
+    std::string message;                        // reused for every message
+
+    StreamServer() = default;
+    void dropViewer();
+
+public:
+    // starts listening, returns nullptr on failure
+    static std::unique_ptr<StreamServer> listen(const std::string& address, int rows, int cols);
+
+    ~StreamServer();
+    StreamServer(const StreamServer&) = delete;
+    StreamServer& operator=(const StreamServer&) = delete;
+
+    // accepts a viewer if none is connected, waiting up to timeoutMs; returns whether one is
+    bool waitForViewer(int timeoutMs);
+
+    // sends a snapshot to the viewer, returns false if the viewer left or stalled
+    bool send(const Snapshot& snapshot);
+};
+
+// receives the stream of a StreamServer and rebuilds its snapshots
+class StreamClient {
+    int socket {-1};
+    Snapshot current;
+    std::string received;                       // bytes read ahead of the messages applied
+    size_t start {};                            // where the next message begins in received
+
+    StreamClient() = default;
+
+    // size of the message at the front of received with its length, 0 if not all there
+    size_t queuedMessage() const;
+
+    // appends what the socket has to received, waiting for data if asked to; returns
+    // false if nothing was read
+    bool fill(bool wait);
+
+public:
+    // connects and reads the hello, returns nullptr on failure
+    static std::unique_ptr<StreamClient> connect(const std::string& address);
+
+    ~StreamClient();
+    StreamClient(const StreamClient&) = delete;
+    StreamClient& operator=(const StreamClient&) = delete;
+
+    // waits for the next message and applies it, returns false when the stream ended
+    // or was malformed
+    bool receive();
+
+    // reads what has arrived without waiting and returns whether a whole message is
+    // queued, so drawing can wait for it; a partly received one does not count
+    bool pending();
+
+    // board as of the last message; version counts the messages received
+    const Snapshot& snapshot() const {
+        return current;
+    }
+};
+
+#endif
@@ -0,0 +1,81 @@
+#include <algorithm>
+#include <thread>
+#include "snapshot.h"
+
+uint64_t packWord(const std::vector<bool>& row, const int word) {
+    uint64_t bits = 0;
+    const int end = std::min(static_cast<int>(row.size()), (word + 1) * 64);
+    for (int col = word * 64; col < end; col++) {
+        bits |= static_cast<uint64_t>(row[col]) << (col % 64);
+    }
+    return bits;
+}
+
+void packSnapshot(const std::vector<std::vector<bool>>& grid, Snapshot& snapshot) {
+    snapshot.rows        = static_cast<int>(grid.size());
+    snapshot.cols        = grid.empty() ? 0 : static_cast<int>(grid[0].size());
+    snapshot.wordsPerRow = (snapshot.cols + 63) / 64;
+    snapshot.words.resize(static_cast<size_t>(snapshot.rows) * snapshot.wordsPerRow);
+    for (int row = 0; row < snapshot.rows; row++) {
+        for (int word = 0; word < snapshot.wordsPerRow; word++) {
+            snapshot.words[static_cast<size_t>(row) * snapshot.wordsPerRow + word] = packWord(grid[row], word);
+        }
+    }
+}
+
+SnapshotPublisher::SnapshotPublisher(const int rows, const int cols)
+    : rows(rows), cols(cols), wordsPerRow((cols + 63) / 64),
+      words(std::make_unique<std::atomic<uint64_t>[]>(static_cast<size_t>(rows) * wordsPerRow)) {}
+
+void SnapshotPublisher::publish(const std::vector<std::vector<bool>>& grid, const int generation,
+                                const int aliveCells, const int totalBirths, const int totalDeaths) {
+    const uint64_t start = sequence.load(std::memory_order_relaxed);
+    sequence.store(start + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (int row = 0; row < rows; row++) {
+        for (int word = 0; word < wordsPerRow; word++) {
+            words[static_cast<size_t>(row) * wordsPerRow + word].store(packWord(grid[row], word),
+                                                                       std::memory_order_relaxed);
+        }
+    }
+    this->generation.store(generation, std::memory_order_relaxed);
+    this->aliveCells.store(aliveCells, std::memory_order_relaxed);
+    this->totalBirths.store(totalBirths, std::memory_order_relaxed);
+    this->totalDeaths.store(totalDeaths, std::memory_order_relaxed);
+
+    sequence.store(start + 2, std::memory_order_release);
+}
+
+bool SnapshotPublisher::read(Snapshot& snapshot) const {
+    const size_t count = static_cast<size_t>(rows) * wordsPerRow;
+    snapshot.rows        = rows;
+    snapshot.cols        = cols;
+    snapshot.wordsPerRow = wordsPerRow;
+    snapshot.words.resize(count);
+
+    while (true) {
+        const uint64_t before = sequence.load(std::memory_order_acquire);
+        if (before == 0) {
+            return false;
+        }
+        if (before % 2 == 1) {
+            std::this_thread::yield();  // the writer is in the middle of a publication
+            continue;
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            snapshot.words[i] = words[i].load(std::memory_order_relaxed);
+        }
+        snapshot.generation  = generation.load(std::memory_order_relaxed);
+        snapshot.aliveCells  = aliveCells.load(std::memory_order_relaxed);
+        snapshot.totalBirths = totalBirths.load(std::memory_order_relaxed);
+        snapshot.totalDeaths = totalDeaths.load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence.load(std::memory_order_relaxed) == before) {
+            snapshot.version = before / 2;
+            return true;
+        }
+    }
+}
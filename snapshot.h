@@ -0,0 +1,72 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/*
+ * Snapshot - consistent copy of the grid at one generation.
+ *
+ * Cells are packed 64 per word, LSB first, each row starting at a new word.
+ */
+struct Snapshot {
+    int rows        {};
+    int cols        {};
+    int wordsPerRow {};
+    int generation  {};
+    int aliveCells  {};
+    int totalBirths {};
+    int totalDeaths {};
+    uint64_t version {};                        // number of publications when this was taken
+    std::vector<uint64_t> words;                // packed cells
+
+    bool get(const int row, const int col) const {
+        return (words[static_cast<size_t>(row) * wordsPerRow + col / 64] >> (col % 64)) & 1;
+    }
+};
+
+// packs one word of a row of cells, word w holds columns 64w to 64w+63
+uint64_t packWord(const std::vector<bool>& row, int word);
+
+// packs the cells of a grid into the snapshot, leaving the counters alone
+void packSnapshot(const std::vector<std::vector<bool>>& grid, Snapshot& snapshot);
+
+/*
+ * SnapshotPublisher - hands the latest generation from the engine to any number of
+ * consumers (renderers, exporters, metrics) without locks.
+ *
+ * It is a seqlock: the single writer bumps the sequence to an odd value, stores the
+ * cells and bumps it to an even value again, so publishing never waits for readers.
+ * A reader copies everything and retries if the sequence changed meanwhile, so each
+ * consumer reads a consistent snapshot at its own rate and may skip generations.
+ */
+class SnapshotPublisher {
+    int rows;
+    int cols;
+    int wordsPerRow;
+    std::atomic<uint64_t> sequence {};          // odd while a snapshot is being written
+    std::atomic<int> generation  {};
+    std::atomic<int> aliveCells  {};
+    std::atomic<int> totalBirths {};
+    std::atomic<int> totalDeaths {};
+    std::unique_ptr<std::atomic<uint64_t>[]> words;
+
+public:
+    SnapshotPublisher(int rows, int cols);
+
+    // publishes a generation, must only be called from one thread
+    void publish(const std::vector<std::vector<bool>>& grid, int generation,
+                 int aliveCells, int totalBirths, int totalDeaths);
+
+    // copies the latest snapshot, returns false if nothing was published yet
+    bool read(Snapshot& snapshot) const;
+
+    // number of publications so far, lets readers skip unchanged generations
+    uint64_t version() const {
+        return sequence.load(std::memory_order_acquire) / 2;
+    }
+};
+
+#endif
@@ -0,0 +1,159 @@
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include "soupmodel.h"
+#include "textio.h"
+
+namespace {
+
+constexpr int EARLY_GENERATIONS {16};           // generations run to compute the features
+constexpr int BOARD_ROWS {SOUP_SIDE + 2 * EARLY_GENERATIONS};   // room to grow without touching the border
+constexpr int SOUP_COLUMN {24};                 // leftmost soup column, soups reach 8-55 of 64
+constexpr double PRIOR_VARIANCE {1000.0};       // initial uncertainty of the weights
+constexpr size_t MAX_HISTORY_LINE {64};
+
+static_assert(SOUP_COLUMN - EARLY_GENERATIONS >= 1 && SOUP_COLUMN + SOUP_SIDE + EARLY_GENERATIONS <= 63,
+              "soups must stay inside one word per row");
+
+using Board = std::array<uint64_t, BOARD_ROWS>;
+
+// one generation of the whole board, neighbor counts are added bit-sliced per row
+Board stepBoard(const Board& board) {
+    Board next {};
+    for (int i = 0; i < BOARD_ROWS; i++) {
+        const uint64_t up   = i > 0 ? board[i - 1] : 0;
+        const uint64_t mid  = board[i];
+        const uint64_t down = i + 1 < BOARD_ROWS ? board[i + 1] : 0;
+
+        uint64_t ones = 0, twos = 0, fours = 0;     // bits of the neighbor count, four and up saturate
+        for (const uint64_t neighbor : {up << 1, up, up >> 1, mid << 1, mid >> 1, down << 1, down, down >> 1}) {
+            const uint64_t carry = ones & neighbor;
+            ones ^= neighbor;
+            fours |= twos & carry;
+            twos ^= carry;
+        }
+        // two neighbors keep a live cell, three keep or create one
+        next[i] = twos & ~fours & (ones | mid);
+    }
+    return next;
+}
+
+int population(const Board& board) {
+    int count = 0;
+    for (const uint64_t row : board) {
+        count += std::popcount(row);
+    }
+    return count;
+}
+
+// 4x4 tiles in which some cell differs between two boards
+int activeTiles(const Board& before, const Board& after) {
+    int tiles = 0;
+    for (int i = 0; i < BOARD_ROWS; i += 4) {
+        uint64_t changed = 0;
+        for (int k = i; k < std::min(i + 4, BOARD_ROWS); k++) {
+            changed |= before[k] ^ after[k];
+        }
+        for (int nibble = 0; nibble < 16; nibble++) {
+            tiles += ((changed >> (nibble * 4)) & 0xf) != 0;
+        }
+    }
+    return tiles;
+}
+
+} // namespace
+
+SoupFeatures soupFeatures(const Soup& soup) {
+    Board board {};
+    for (int i = 0; i < SOUP_SIDE; i++) {
+        for (int j = 0; j < SOUP_SIDE; j++) {
+            if (soup.get(i, j)) {
+                board[EARLY_GENERATIONS + i] |= 1ull << (SOUP_COLUMN + j);
+            }
+        }
+    }
+
+    const int start = population(board);
+    std::array<int, 3> populations {};          // after 4, 8 and 16 generations
+    Board previous = board;
+    for (int generation = 1; generation <= EARLY_GENERATIONS; generation++) {
+        previous = board;
+        board = stepBoard(board);
+        if (generation == 4) populations[0] = population(board);
+        if (generation == 8) populations[1] = population(board);
+    }
+    populations[2] = population(board);
+
+    const double scale = start > 0 ? 1.0 / start : 0.0;
+    return {
+        1.0,                                    // bias
+        static_cast<double>(start) / (SOUP_SIDE * SOUP_SIDE),
+        populations[0] * scale,
+        populations[1] * scale,
+        populations[2] * scale,
+        activeTiles(previous, board) / 16.0,
+        populations[2] > 0 && populations[2] == populations[1] ? 1.0 : 0.0,    // early plateau
+    };
+}
+
+StabilizationModel::StabilizationModel() {
+    for (int i = 0; i < SOUP_FEATURES; i++) {
+        covariance[i][i] = PRIOR_VARIANCE;
+    }
+}
+
+void StabilizationModel::update(const SoupFeatures& features, const int generations) {
+    // gain = P x / (1 + x' P x), then the weights move by gain * error and P shrinks
+    std::array<double, SOUP_FEATURES> px {};
+    double denominator = 1.0;
+    for (int i = 0; i < SOUP_FEATURES; i++) {
+        for (int j = 0; j < SOUP_FEATURES; j++) {
+            px[i] += covariance[i][j] * features[j];
+        }
+        denominator += features[i] * px[i];
+    }
+
+    double error = std::log1p(static_cast<double>(generations));
+    for (int i = 0; i < SOUP_FEATURES; i++) {
+        error -= weights[i] * features[i];
+    }
+    for (int i = 0; i < SOUP_FEATURES; i++) {
+        weights[i] += px[i] / denominator * error;
+    }
+    for (int i = 0; i < SOUP_FEATURES; i++) {
+        for (int j = 0; j < SOUP_FEATURES; j++) {
+            covariance[i][j] -= px[i] * px[j] / denominator;
+        }
+    }
+    samples++;
+}
+
+double StabilizationModel::predict(const SoupFeatures& features) const {
+    double logGenerations = 0;
+    for (int i = 0; i < SOUP_FEATURES; i++) {
+        logGenerations += weights[i] * features[i];
+    }
+    return std::expm1(logGenerations);
+}
+
+bool StabilizationModel::learnHistory(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        return true;
+    }
+
+    std::string line;
+    while (readLine(in, line, MAX_HISTORY_LINE)) {
+        if (line.empty() || line[0] == '#') continue;
+        unsigned long long seed = 0;
+        int generations = 0;
+        char rest = 0;
+        if (std::sscanf(line.c_str(), "%llu,%d %c", &seed, &generations, &rest) != 2 || generations < 0) {
+            return false;
+        }
+        update(soupFeatures(generateSoup(seed)), generations);
+    }
+    return !in.bad();
+}
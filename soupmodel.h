@@ -0,0 +1,45 @@
+#ifndef SOUPMODEL_H
+#define SOUPMODEL_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include "soupring.h"
+
+constexpr int SOUP_FEATURES {7};                // values describing a soup to the model
+
+// cheap description of a soup: initial density and how population and activity develop
+// over its first generations, run on a 64-bit wide bitboard with a dead border
+using SoupFeatures = std::array<double, SOUP_FEATURES>;
+
+SoupFeatures soupFeatures(const Soup& soup);
+
+/*
+ * StabilizationModel - online predictor of the generations a soup takes to stabilize.
+ *
+ * Linear in the soup features, fitted to log(1 + generations) by recursive least
+ * squares: each finished soup updates the weights in constant time, without keeping
+ * past records. Only the order of predictions matters to the scheduler.
+ */
+class StabilizationModel {
+    std::array<double, SOUP_FEATURES> weights {};
+    std::array<std::array<double, SOUP_FEATURES>, SOUP_FEATURES> covariance {};
+    long long samples {};
+
+public:
+    StabilizationModel();
+
+    // learns from one finished soup
+    void update(const SoupFeatures& features, int generations);
+
+    // predicted generations to stabilize
+    double predict(const SoupFeatures& features) const;
+
+    long long getSamples() const { return samples; }
+
+    // learns from a history of "seed,generations" lines written by earlier runs;
+    // a missing file is an empty history, returns false on malformed input
+    bool learnHistory(const std::string& path);
+};
+
+#endif
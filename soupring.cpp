@@ -0,0 +1,190 @@
+#include <new>
+#include <random>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "soupring.h"
+
+namespace {
+
+constexpr uint64_t RING_MAGIC {0x70756f53656c6966ull};  // marks an initialized ring
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "atomics must work across processes");
+
+} // namespace
+
+struct SoupRing::Header {
+    uint64_t magic {};
+    uint32_t capacity {};
+    alignas(64) std::atomic<uint64_t> head {};      // next position the producer writes
+    alignas(64) std::atomic<uint64_t> tail {};      // next position a worker takes
+    alignas(64) std::atomic<uint64_t> closed {};    // no more soups will be pushed
+    std::atomic<uint64_t> completed {};
+    std::atomic<uint64_t> unstable {};
+    std::atomic<uint64_t> deferred {};
+};
+
+struct SoupRing::Slot {
+    std::atomic<uint64_t> sequence {};          // position the slot is ready for
+    Soup soup;
+};
+
+Soup generateSoup(const uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    Soup soup;
+    soup.seed = seed;
+    for (int index = 0; index < SOUP_SIDE * SOUP_SIDE; index++) {
+        soup.bits[index / 64] |= static_cast<uint64_t>(rng() & 1) << (index % 64);
+    }
+    return soup;
+}
+
+bool SoupRing::map(const int fd, const size_t size) {
+    void* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED) {
+        return false;
+    }
+    mappedSize = size;
+    header = static_cast<Header*>(memory);
+    slots  = reinterpret_cast<Slot*>(static_cast<char*>(memory) + sizeof(Header));
+    return true;
+}
+
+std::unique_ptr<SoupRing> SoupRing::create(const std::string& name, const uint32_t capacity) {
+    if (capacity == 0) {
+        return nullptr;
+    }
+    const int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd == -1) {
+        return nullptr;
+    }
+
+    std::unique_ptr<SoupRing> ring(new SoupRing());
+    ring->name  = name;
+    ring->owner = true;
+    const size_t size = sizeof(Header) + capacity * sizeof(Slot);
+    if (ftruncate(fd, static_cast<off_t>(size)) == -1 || !ring->map(fd, size)) {
+        return nullptr;
+    }
+
+    new (ring->header) Header();
+    for (uint32_t i = 0; i < capacity; i++) {
+        new (&ring->slots[i]) Slot();
+        ring->slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    ring->header->capacity = capacity;
+    std::atomic_thread_fence(std::memory_order_release);
+    ring->header->magic = RING_MAGIC;
+    return ring;
+}
+
+std::unique_ptr<SoupRing> SoupRing::attach(const std::string& name) {
+    const int fd = shm_open(name.c_str(), O_RDWR, 0600);
+    if (fd == -1) {
+        return nullptr;
+    }
+
+    struct {
+        uint64_t magic;
+        uint32_t capacity;
+    } probe {};                                 // leading fields of the header
+    if (pread(fd, &probe, sizeof(probe), 0) != static_cast<ssize_t>(sizeof(probe)) ||
+        probe.magic != RING_MAGIC) {
+        ::close(fd);
+        return nullptr;
+    }
+
+    std::unique_ptr<SoupRing> ring(new SoupRing());
+    ring->name = name;
+    if (!ring->map(fd, sizeof(Header) + probe.capacity * sizeof(Slot))) {
+        return nullptr;
+    }
+    return ring;
+}
+
+SoupRing::~SoupRing() {
+    if (header != nullptr) {
+        munmap(header, mappedSize);
+    }
+    if (owner) {
+        shm_unlink(name.c_str());
+    }
+}
+
+bool SoupRing::tryPush(const Soup& soup) {
+    const uint64_t capacity = header->capacity;
+    uint64_t position = header->head.load(std::memory_order_relaxed);
+
+    while (true) {
+        Slot& slot = slots[position % capacity];
+        const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+
+        if (sequence == position) {
+            if (header->head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                slot.soup = soup;
+                slot.sequence.store(position + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (sequence < position) {
+            return false;   // the slot still holds a soup from one lap ago
+        } else {
+            position = header->head.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+SoupRing::PopResult SoupRing::tryPop(Soup& soup) {
+    const uint64_t capacity = header->capacity;
+    uint64_t position = header->tail.load(std::memory_order_relaxed);
+
+    while (true) {
+        Slot& slot = slots[position % capacity];
+        const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+
+        if (sequence == position + 1) {
+            if (header->tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                soup = slot.soup;
+                slot.sequence.store(position + capacity, std::memory_order_release);
+                return PopResult::Taken;
+            }
+        } else if (sequence < position + 1) {
+            // closed counts only if the slot is still empty after seeing the flag,
+            // since the last soup may have been pushed just before closing
+            if (header->closed.load(std::memory_order_acquire) &&
+                slot.sequence.load(std::memory_order_acquire) < position + 1) {
+                return PopResult::Closed;
+            }
+            return PopResult::Empty;
+        } else {
+            position = header->tail.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void SoupRing::close() {
+    header->closed.store(1, std::memory_order_release);
+}
+
+void SoupRing::reportResult(const bool stabilized) {
+    header->completed.fetch_add(1, std::memory_order_relaxed);
+    if (!stabilized) {
+        header->unstable.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void SoupRing::reportDeferred() {
+    header->deferred.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t SoupRing::completed() const {
+    return header->completed.load(std::memory_order_relaxed);
+}
+
+uint64_t SoupRing::unstable() const {
+    return header->unstable.load(std::memory_order_relaxed);
+}
+
+uint64_t SoupRing::deferred() const {
+    return header->deferred.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,84 @@
+#ifndef SOUPRING_H
+#define SOUPRING_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+constexpr int SOUP_SIDE {16};                   // side of the random square of a soup
+
+// seeded random soup packed row by row, LSB first
+struct Soup {
+    uint64_t seed {};
+    uint64_t bits[SOUP_SIDE * SOUP_SIDE / 64] {};
+
+    bool get(const int row, const int col) const {
+        const int index = row * SOUP_SIDE + col;
+        return (bits[index / 64] >> (index % 64)) & 1;
+    }
+};
+
+// draws the soup of a seed; the same seed gives the same soup on every host
+Soup generateSoup(uint64_t seed);
+
+/*
+ * SoupRing - bounded queue of soups in POSIX shared memory.
+ *
+ * One producer generates soups and any number of worker processes, forked or
+ * started separately with the ring name, take them out, so generation, simulation
+ * and census can be scaled independently. Slots carry sequence numbers (a Vyukov
+ * bounded queue), so producer and workers never take a lock. Nothing blocks:
+ * callers decide how to wait when the ring is full or empty.
+ */
+class SoupRing {
+    struct Header;
+    struct Slot;
+
+    Header* header {};
+    Slot* slots    {};
+    size_t mappedSize {};
+    std::string name;
+    bool owner {};                              // unlinks the shared memory on destruction
+
+    SoupRing() = default;
+    bool map(int fd, size_t size);
+
+public:
+    // creates a new ring, name must start with '/', returns nullptr on failure
+    static std::unique_ptr<SoupRing> create(const std::string& name, uint32_t capacity);
+
+    // attaches to a ring created by another process, returns nullptr on failure
+    static std::unique_ptr<SoupRing> attach(const std::string& name);
+
+    ~SoupRing();
+    SoupRing(const SoupRing&) = delete;
+    SoupRing& operator=(const SoupRing&) = delete;
+
+    enum class PopResult {
+        Taken,                                  // a soup was taken
+        Empty,                                  // the producer may still add soups
+        Closed,                                 // the producer is done and the ring is drained
+    };
+
+    // adds a soup, returns false if the ring is full
+    bool tryPush(const Soup& soup);
+
+    // takes a soup if there is one
+    PopResult tryPop(Soup& soup);
+
+    // tells the workers that no more soups will come
+    void close();
+
+    // counts a soup finished by a worker
+    void reportResult(bool stabilized);
+
+    // counts a soup a worker handed on to another ring instead of finishing it
+    void reportDeferred();
+
+    uint64_t completed() const;                 // soups finished by all workers
+    uint64_t unstable() const;                  // of those, soups that did not stabilize
+    uint64_t deferred() const;                  // soups handed on unfinished
+};
+
+#endif
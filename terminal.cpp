@@ -0,0 +1,90 @@
+#include <cerrno>
+#include <chrono>
+#include <thread>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#include "terminal.h"
+
+namespace {
+
+constexpr int ESCAPE_TIMEOUT_MS {10};           // time to wait for the rest of an escape sequence
+
+// waits up to timeoutMs for one byte, returns -1 on timeout and -2 on end of file
+int readByte(const int timeoutMs) {
+    pollfd input {STDIN_FILENO, POLLIN, 0};
+    if (poll(&input, 1, timeoutMs) <= 0) {
+        return -1;
+    }
+    unsigned char byte;
+    return read(STDIN_FILENO, &byte, 1) == 1 ? byte : -2;
+}
+
+} // namespace
+
+std::pair<int, int> terminalSize() {
+    struct winsize size {};
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) == -1 || size.ws_row == 0 || size.ws_col == 0) {
+        return {24, 80};
+    }
+    return {size.ws_row, size.ws_col};
+}
+
+bool writeFrame(std::string_view frame) {
+    while (!frame.empty()) {
+        const ssize_t written = write(STDOUT_FILENO, frame.data(), frame.size());
+        if (written < 0 && errno == EINTR) continue;
+        if (written <= 0) {
+            return false;
+        }
+        frame.remove_prefix(static_cast<size_t>(written));
+    }
+    return true;
+}
+
+RawInput::RawInput() {
+    if (tcgetattr(STDIN_FILENO, &saved) == 0) {
+        termios settings = saved;
+        settings.c_lflag &= ~(ICANON | ECHO);
+        settings.c_cc[VMIN]  = 1;
+        settings.c_cc[VTIME] = 0;
+        raw = tcsetattr(STDIN_FILENO, TCSANOW, &settings) == 0;
+    }
+}
+
+RawInput::~RawInput() {
+    if (raw) {
+        tcsetattr(STDIN_FILENO, TCSANOW, &saved);
+    }
+}
+
+int RawInput::readKey(const int timeoutMs) {
+    if (closed) {
+        // nothing more will arrive, keep the caller's pace
+        if (timeoutMs >= 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(timeoutMs));
+        }
+        return KEY_NONE;
+    }
+
+    const int byte = readByte(timeoutMs);
+    if (byte == -2) {
+        closed = true;
+        return KEY_NONE;
+    }
+    if (byte != '\033') {
+        return byte < 0 ? KEY_NONE : byte;
+    }
+
+    // arrow keys arrive as ESC [ A-D
+    if (readByte(ESCAPE_TIMEOUT_MS) != '[') {
+        return '\033';
+    }
+    switch (readByte(ESCAPE_TIMEOUT_MS)) {
+        case 'A': return KEY_UP;
+        case 'B': return KEY_DOWN;
+        case 'C': return KEY_RIGHT;
+        case 'D': return KEY_LEFT;
+        default:  return KEY_NONE;
+    }
+}
@@ -0,0 +1,46 @@
+#ifndef TERMINAL_H
+#define TERMINAL_H
+
+#include <string_view>
+#include <termios.h>
+#include <utility>
+
+// special keys returned by RawInput::readKey, printable keys are returned as is
+enum Key {
+    KEY_NONE  = -1,                             // no key pressed before the timeout
+    KEY_UP    = 1000,
+    KEY_DOWN,
+    KEY_RIGHT,
+    KEY_LEFT,
+};
+
+// rows and columns of the terminal on stdout, 24x80 when it is not a terminal
+std::pair<int, int> terminalSize();
+
+// writes a whole frame to stdout, in one write() unless the terminal takes less at once
+bool writeFrame(std::string_view frame);
+
+/*
+ * RawInput - reads single key presses from the terminal while the simulation runs.
+ *
+ * Switches stdin to non-canonical mode without echo and restores the previous
+ * settings on destruction. When stdin is not a terminal keys are still read,
+ * but only once a line is complete.
+ */
+class RawInput {
+    termios saved {};                           // settings restored on destruction
+    bool raw      {};                           // whether the settings were changed
+    bool closed   {};                           // stdin reached end of file
+
+public:
+    RawInput();
+    ~RawInput();
+
+    RawInput(const RawInput&) = delete;
+    RawInput& operator=(const RawInput&) = delete;
+
+    // waits up to timeoutMs (-1=forever) for a key, returns KEY_NONE on timeout
+    int readKey(int timeoutMs);
+};
+
+#endif
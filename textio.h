@@ -0,0 +1,35 @@
+#ifndef TEXTIO_H
+#define TEXTIO_H
+
+#include <cstddef>
+#include <istream>
+#include <string>
+
+// reads a line like std::getline, but sets badbit instead of growing the line past
+// maxLength, so a file without line breaks cannot exhaust memory
+inline bool readLine(std::istream& in, std::string& line, const size_t maxLength) {
+    line.clear();
+    std::streambuf* buffer = in.rdbuf();
+    if (!in.good() || buffer == nullptr) {
+        in.setstate(std::ios::failbit);
+        return false;
+    }
+
+    while (true) {
+        const int c = buffer->sbumpc();
+        if (c == std::char_traits<char>::eof()) {
+            in.setstate(line.empty() ? std::ios::eofbit | std::ios::failbit : std::ios::eofbit);
+            return !line.empty();
+        }
+        if (c == '\n') {
+            return true;
+        }
+        if (line.size() == maxLength) {
+            in.setstate(std::ios::badbit);
+            return false;
+        }
+        line.push_back(static_cast<char>(c));
+    }
+}
+
+#endif
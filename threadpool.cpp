@@ -0,0 +1,70 @@
+#include <algorithm>
+#include "threadpool.h"
+
+ThreadPool::ThreadPool(int threads) {
+    if (threads <= 0) {
+        threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+    for (int i = 1; i < threads; i++) {
+        workers.emplace_back([this] { workerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    workers.clear();    // join before the mutex and condition variables are destroyed
+}
+
+void ThreadPool::runBatches() {
+    while (true) {
+        const size_t begin = next.fetch_add(batchSize, std::memory_order_relaxed);
+        if (begin >= count) {
+            return;
+        }
+        task(begin, std::min(count, begin + batchSize));
+    }
+}
+
+void ThreadPool::workerLoop() {
+    uint64_t seen = 0;
+    while (true) {
+        {
+            std::unique_lock lock(mutex);
+            wake.wait(lock, [&] { return stopping || round != seen; });
+            if (stopping) {
+                return;
+            }
+            seen = round;
+        }
+
+        runBatches();
+
+        std::lock_guard lock(mutex);
+        if (--busy == 0) {
+            done.notify_one();
+        }
+    }
+}
+
+void ThreadPool::parallelFor(const size_t count, const size_t batchSize,
+                             const std::function<void(size_t, size_t)>& task) {
+    {
+        std::lock_guard lock(mutex);
+        this->task      = task;
+        this->count     = count;
+        this->batchSize = std::max<size_t>(batchSize, 1);
+        next.store(0, std::memory_order_relaxed);
+        busy = static_cast<int>(workers.size());
+        round++;
+    }
+    wake.notify_all();
+
+    runBatches();
+
+    std::unique_lock lock(mutex);
+    done.wait(lock, [&] { return busy == 0; });
+}
@@ -0,0 +1,49 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+ * ThreadPool - persistent worker threads for data-parallel loops.
+ *
+ * parallelFor hands out batches of indices through one atomic counter, so the cost
+ * of waking the workers is paid once per call rather than once per item. The
+ * calling thread works too. Calls must not overlap or nest.
+ */
+class ThreadPool {
+    std::vector<std::jthread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;               // signals workers that a new loop started
+    std::condition_variable done;               // signals the caller that all workers finished
+    std::function<void(size_t, size_t)> task;   // current loop body, called with [begin, end)
+    size_t count     {};                        // indices of the current loop
+    size_t batchSize {};                        // indices taken at once
+    std::atomic<size_t> next {};                // first index not handed out yet
+    uint64_t round   {};                        // number of loops started, wakes the workers
+    int busy         {};                        // workers still running the current loop
+    bool stopping    {};
+
+    void runBatches();
+    void workerLoop();
+
+public:
+    // starts threads-1 workers (0=one thread per core), the caller is the last thread
+    explicit ThreadPool(int threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // runs task(begin, end) over [0, count) in batches and returns when all are done
+    void parallelFor(size_t count, size_t batchSize, const std::function<void(size_t, size_t)>& task);
+
+    int size() const { return static_cast<int>(workers.size()) + 1; }
+};
+
+#endif
@@ -0,0 +1,99 @@
+#include <algorithm>
+#include <atomic>
+#include <csignal>
+#include <iostream>
+#include <string_view>
+#include "framebuffer.h"
+#include "remote.h"
+#include "terminal.h"
+
+namespace {
+
+constexpr std::string_view ALIVE_CELL {"■ "};
+constexpr std::string_view DEAD_CELL  {"  "};
+constexpr int STATUS_LINES {2};                 // below the cells
+
+// set by SIGINT and SIGTERM; the blocked read returns and the viewer quits
+std::atomic<bool> stopRequested {false};
+
+extern "C" void requestStop(int) {
+    stopRequested.store(true, std::memory_order_relaxed);
+}
+
+// draws the top left of the board that fits on the terminal
+void draw(FrameBuffer& frame, const Snapshot& snapshot, const int viewRows, const int viewCols,
+          const long long received, const long long dropped) {
+    frame.begin();
+    for (int i = 0; i < std::min(viewRows, snapshot.rows); i++) {
+        for (int j = 0; j < std::min(viewCols, snapshot.cols); j++) {
+            frame << (snapshot.get(i, j) ? ALIVE_CELL : DEAD_CELL);
+        }
+        frame << "\033[K\n";
+    }
+    frame << "\033[K\nGeneration: "  << snapshot.generation
+          << " | Alive cells: "      << snapshot.aliveCells
+          << " | Total births: "     << snapshot.totalBirths
+          << " | Total deaths: "     << snapshot.totalDeaths
+          << " | Received: "         << received
+          << " | Dropped: "          << dropped
+          << " | Frame: "            << frame.getBuildTime().count() / 1000 << " us\033[K\033[J";
+    frame.flush();
+}
+
+} // namespace
+
+/*
+ * viewer - shows a simulation streamed by --serve, possibly from another host.
+ *
+ * Usage: viewer unix:<path> | [<host>:]<port>
+ * The board is rebuilt locally from per-generation deltas. When several generations
+ * arrive while one is drawn only the newest is drawn; generations the simulation
+ * skipped because the link was busy are counted as dropped. Ctrl+C quits.
+ */
+int main(int argc, char* argv[]) {
+    if (argc != 2) {
+        std::cerr << "Usage: " << argv[0] << " unix:<path> | [<host>:]<port>\n";
+        return 1;
+    }
+
+    // no SA_RESTART, so the blocked read returns and the viewer notices
+    struct sigaction action {};
+    action.sa_handler = requestStop;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+
+    const auto client = StreamClient::connect(argv[1]);
+    if (!client) {
+        std::cerr << "Failed to connect to " << argv[1] << "\n";
+        return 1;
+    }
+
+    FrameBuffer frame;
+    std::pair<int, int> terminal;
+    long long received = 0;
+    long long dropped  = 0;
+    int lastGeneration = -1;
+    std::cout << "\033[?25l";   // hide cursor while drawing
+
+    while (!stopRequested && client->receive()) {
+        const Snapshot& snapshot = client->snapshot();
+        received++;
+        if (lastGeneration >= 0 && snapshot.generation > lastGeneration + 1) {
+            dropped += snapshot.generation - lastGeneration - 1;
+        }
+        lastGeneration = snapshot.generation;
+        if (client->pending()) continue;    // a newer generation is already here
+
+        if (const auto size = terminalSize(); size != terminal) {
+            terminal = size;
+            frame.reserve(static_cast<size_t>(size.first) * (size.second * ALIVE_CELL.size() + 8) + 256);
+            std::cout << "\033[2J";
+        }
+        draw(frame, snapshot, terminal.first - STATUS_LINES, terminal.second / 2, received, dropped);
+    }
+
+    std::cout << "\033[?25h\n" << (stopRequested ? "Stopped" : "Stream ended") << " after " << received
+              << " generations\n";
+    return 0;
+}